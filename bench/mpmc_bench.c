@@ -0,0 +1,277 @@
+/**
+ * @file      : mpmc_bench.c
+ * @brief     : 多生产者多消费者吞吐量测试
+ *              N个生产者线程和M个消费者线程传递8字节元素, 对比无锁队列mpmc_queue_t和互斥锁队列queue_t(固定大小元素模式)
+ *              生产者不等待写入, 队列满时让出CPU后重试; 消费者超时等待, 全部元素取完后退出
+ *              编译: gcc -std=gnu11 -O2 -pthread -I.. mpmc_bench.c ../mpmc_queue.c ../queue.c -o mpmc_bench
+ *              运行: ./mpmc_bench(默认测试1x1, 2x2, 4x4), ./mpmc_bench 8 2(指定生产者和消费者个数)
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-17 00:00:00
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-17 huenrong        创建文件
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include "queue.h"
+#include "mpmc_queue.h"
+
+#define BENCH_QUEUE_SIZE 1024   // 队列容量(元素个数)
+#define BENCH_ELEM_NUM 2000000  // 每次测试传递的元素总数
+#define BENCH_MAX_THREAD_NUM 64 // 生产者和消费者的最大个数
+#define BENCH_GET_TIMEOUT 100   // 消费者超时时间(单位: ms)
+
+// 被测队列类型
+typedef enum
+{
+    BENCH_QUEUE_MPMC = 0,  // 无锁队列mpmc_queue_t
+    BENCH_QUEUE_MUTEX = 1, // 互斥锁队列queue_t
+} bench_queue_type_t;
+
+// 测试上下文
+typedef struct
+{
+    bench_queue_type_t type; // 被测队列类型
+    mpmc_queue_t mpmc_queue; // 无锁队列
+    queue_t mutex_queue;     // 互斥锁队列
+    uint32_t producer_num;   // 生产者个数
+    uint64_t got_num;        // 已获取的元素个数
+    uint64_t got_sum;        // 已获取的元素之和(校验数据)
+} bench_ctx_t;
+
+// 生产者参数
+typedef struct
+{
+    bench_ctx_t *ctx; // 测试上下文
+    uint32_t index;   // 生产者序号
+} bench_producer_t;
+
+/**
+ * @brief  获取当前时间(CLOCK_MONOTONIC时钟)
+ * @return 当前时间(单位: ns)
+ */
+static uint64_t bench_get_time_ns(void)
+{
+    struct timespec now = {0};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (((uint64_t)now.tv_sec * 1000000000ULL) + now.tv_nsec);
+}
+
+/**
+ * @brief  生产者线程: 写入序号为index, index + producer_num, ...的元素
+ * @param  arg: 输入参数, 生产者参数
+ * @return NULL
+ */
+static void *bench_producer_thread(void *arg)
+{
+    bench_producer_t *producer = (bench_producer_t *)arg;
+    bench_ctx_t *ctx = producer->ctx;
+
+    for (uint64_t value = producer->index; value < BENCH_ELEM_NUM; value += ctx->producer_num)
+    {
+        int ret = 0;
+        while (true)
+        {
+            if (BENCH_QUEUE_MPMC == ctx->type)
+            {
+                ret = mpmc_queue_put_data(&ctx->mpmc_queue, &value, 1);
+            }
+            else
+            {
+                ret = queue_put_elem(&ctx->mutex_queue, &value, 1, 0);
+            }
+
+            if (1 == ret)
+            {
+                break;
+            }
+
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief  消费者线程: 获取元素直到全部元素被取完
+ * @param  arg: 输入参数, 测试上下文
+ * @return NULL
+ */
+static void *bench_consumer_thread(void *arg)
+{
+    bench_ctx_t *ctx = (bench_ctx_t *)arg;
+
+    uint64_t got_num = 0;
+    uint64_t got_sum = 0;
+    while (__atomic_load_n(&ctx->got_num, __ATOMIC_RELAXED) < BENCH_ELEM_NUM)
+    {
+        uint64_t value = 0;
+        int ret = 0;
+        if (BENCH_QUEUE_MPMC == ctx->type)
+        {
+            ret = mpmc_queue_get_data_with_timeout(&ctx->mpmc_queue, &value, 1, BENCH_GET_TIMEOUT);
+        }
+        else
+        {
+            ret = queue_get_elem(&ctx->mutex_queue, &value, 1, BENCH_GET_TIMEOUT);
+        }
+
+        if (1 == ret)
+        {
+            got_num++;
+            got_sum += value;
+
+            // 每1024个元素汇总一次, 减少共享计数器的竞争
+            if (1024 == got_num)
+            {
+                __atomic_add_fetch(&ctx->got_sum, got_sum, __ATOMIC_RELAXED);
+                __atomic_add_fetch(&ctx->got_num, got_num, __ATOMIC_RELAXED);
+                got_num = 0;
+                got_sum = 0;
+            }
+        }
+        else if (got_num > 0)
+        {
+            // 队列暂时为空, 汇总已获取的元素, 保证最后的元素被计入
+            __atomic_add_fetch(&ctx->got_sum, got_sum, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&ctx->got_num, got_num, __ATOMIC_RELAXED);
+            got_num = 0;
+            got_sum = 0;
+        }
+    }
+
+    __atomic_add_fetch(&ctx->got_sum, got_sum, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&ctx->got_num, got_num, __ATOMIC_RELAXED);
+
+    return NULL;
+}
+
+/**
+ * @brief  运行一次测试
+ * @param  type        : 输入参数, 被测队列类型
+ * @param  producer_num: 输入参数, 生产者个数
+ * @param  consumer_num: 输入参数, 消费者个数
+ * @return 每秒传递的元素个数(失败时为0)
+ */
+static double bench_run(const bench_queue_type_t type, const uint32_t producer_num, const uint32_t consumer_num)
+{
+    static bench_ctx_t ctx;
+    ctx.type = type;
+    ctx.producer_num = producer_num;
+    ctx.got_num = 0;
+    ctx.got_sum = 0;
+
+    bool ret = ((BENCH_QUEUE_MPMC == type) ? mpmc_queue_init(&ctx.mpmc_queue, sizeof(uint64_t), BENCH_QUEUE_SIZE)
+                                           : queue_init_elem(&ctx.mutex_queue, sizeof(uint64_t), BENCH_QUEUE_SIZE));
+    if (!ret)
+    {
+        return 0;
+    }
+
+    pthread_t producers[BENCH_MAX_THREAD_NUM];
+    pthread_t consumers[BENCH_MAX_THREAD_NUM];
+    bench_producer_t producer_args[BENCH_MAX_THREAD_NUM];
+
+    uint64_t start_ns = bench_get_time_ns();
+    for (uint32_t i = 0; i < consumer_num; i++)
+    {
+        pthread_create(&consumers[i], NULL, bench_consumer_thread, &ctx);
+    }
+    for (uint32_t i = 0; i < producer_num; i++)
+    {
+        producer_args[i].ctx = &ctx;
+        producer_args[i].index = i;
+        pthread_create(&producers[i], NULL, bench_producer_thread, &producer_args[i]);
+    }
+
+    for (uint32_t i = 0; i < producer_num; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+    for (uint32_t i = 0; i < consumer_num; i++)
+    {
+        pthread_join(consumers[i], NULL);
+    }
+    uint64_t elapsed_ns = (bench_get_time_ns() - start_ns);
+
+    if (BENCH_QUEUE_MPMC == type)
+    {
+        mpmc_queue_destroy(&ctx.mpmc_queue);
+    }
+    else
+    {
+        queue_destroy(&ctx.mutex_queue);
+    }
+
+    // 每个元素只被获取一次
+    uint64_t expect_sum = ((uint64_t)BENCH_ELEM_NUM * (BENCH_ELEM_NUM - 1) / 2);
+    if ((BENCH_ELEM_NUM != ctx.got_num) || (expect_sum != ctx.got_sum))
+    {
+        return 0;
+    }
+
+    return ((double)BENCH_ELEM_NUM * 1000000000.0 / elapsed_ns);
+}
+
+/**
+ * @brief  对比两种队列在指定线程个数下的吞吐量
+ * @param  producer_num: 输入参数, 生产者个数
+ * @param  consumer_num: 输入参数, 消费者个数
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool bench_compare(const uint32_t producer_num, const uint32_t consumer_num)
+{
+    double mpmc_rate = bench_run(BENCH_QUEUE_MPMC, producer_num, consumer_num);
+    double mutex_rate = bench_run(BENCH_QUEUE_MUTEX, producer_num, consumer_num);
+    if ((mpmc_rate <= 0) || (mutex_rate <= 0))
+    {
+        printf("%2ux%-2u failed\n", producer_num, consumer_num);
+
+        return false;
+    }
+
+    printf("%2ux%-2u %14.2f %14.2f\n", producer_num, consumer_num, (mpmc_rate / 1000000), (mutex_rate / 1000000));
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    printf("%-5s %14s %14s\n", "PxC", "mpmc Mops/s", "queue_t Mops/s");
+
+    if (argc > 2)
+    {
+        uint32_t producer_num = (uint32_t)atoi(argv[1]);
+        uint32_t consumer_num = (uint32_t)atoi(argv[2]);
+        if ((0 == producer_num) || (0 == consumer_num) || (producer_num > BENCH_MAX_THREAD_NUM) ||
+            (consumer_num > BENCH_MAX_THREAD_NUM))
+        {
+            printf("thread number must be 1~%d\n", BENCH_MAX_THREAD_NUM);
+
+            return 1;
+        }
+
+        return (bench_compare(producer_num, consumer_num) ? 0 : 1);
+    }
+
+    for (uint32_t thread_num = 1; thread_num <= 4; thread_num *= 2)
+    {
+        if (!bench_compare(thread_num, thread_num))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file      : queue_bench.c
+ * @brief     : 队列读写吞吐量测试
+ *              单线程交替调用queue_put_data()和queue_get_data(), 测量不同数据长度(1B~64KiB)下每秒读写的字节数
+ *              只使用最初版本就有的接口, 可以同时编译新旧queue.c对比
+ *              编译: gcc -std=gnu11 -O2 -pthread -I.. queue_bench.c ../queue.c -o queue_bench
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-16 23:00:00
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-16 huenrong        创建文件
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "queue.h"
+
+#define BENCH_QUEUE_SIZE (256 * 1024) // 队列容量
+#define BENCH_MAX_DATA_LEN (64 * 1024) // 最大数据长度
+#define BENCH_RUN_NS 500000000ULL      // 每种数据长度的测试时间(单位: ns)
+
+/**
+ * @brief  获取当前时间(CLOCK_MONOTONIC时钟)
+ * @return 当前时间(单位: ns)
+ */
+static uint64_t bench_get_time_ns(void)
+{
+    struct timespec now = {0};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (((uint64_t)now.tv_sec * 1000000000ULL) + now.tv_nsec);
+}
+
+/**
+ * @brief  测试指定数据长度的读写吞吐量
+ * @param  queue   : 输入参数, 队列名
+ * @param  data    : 输入参数, 写入数据
+ * @param  buf     : 输出参数, 读取缓冲区
+ * @param  data_len: 输入参数, 数据长度
+ * @return 每秒读写的字节数(失败时为0)
+ */
+static double bench_run(queue_t *queue, const uint8_t *data, uint8_t *buf, const uint32_t data_len)
+{
+    uint64_t total_len = 0;
+    uint64_t start_ns = bench_get_time_ns();
+    uint64_t elapsed_ns = 0;
+
+    // 每1024次读写检查一次时间, 减少clock_gettime()对小数据长度的影响
+    do
+    {
+        for (uint32_t i = 0; i < 1024; i++)
+        {
+            if ((data_len != (uint32_t)queue_put_data(queue, data, data_len)) ||
+                (data_len != (uint32_t)queue_get_data(queue, buf, data_len)))
+            {
+                return 0;
+            }
+        }
+
+        total_len += (1024ULL * data_len);
+        elapsed_ns = (bench_get_time_ns() - start_ns);
+    } while (elapsed_ns < BENCH_RUN_NS);
+
+    return ((double)total_len * 1000000000.0 / elapsed_ns);
+}
+
+int main(void)
+{
+    queue_t queue;
+    if (!queue_init(&queue, BENCH_QUEUE_SIZE))
+    {
+        printf("queue init failed\n");
+
+        return 1;
+    }
+
+    uint8_t *data = malloc(BENCH_MAX_DATA_LEN);
+    uint8_t *buf = malloc(BENCH_MAX_DATA_LEN);
+    if ((!data) || (!buf))
+    {
+        printf("malloc failed\n");
+        free(data);
+        free(buf);
+        queue_destroy(&queue);
+
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < BENCH_MAX_DATA_LEN; i++)
+    {
+        data[i] = (uint8_t)i;
+    }
+
+    printf("%10s %14s\n", "bytes", "MiB/s");
+    for (uint32_t data_len = 1; data_len <= BENCH_MAX_DATA_LEN; data_len *= 4)
+    {
+        double rate = bench_run(&queue, data, buf, data_len);
+        if ((rate <= 0) || (0 != memcmp(data, buf, data_len)))
+        {
+            printf("%10u failed\n", data_len);
+            break;
+        }
+
+        printf("%10u %14.1f\n", data_len, (rate / (1024 * 1024)));
+    }
+
+    free(data);
+    free(buf);
+    queue_destroy(&queue);
+
+    return 0;
+}
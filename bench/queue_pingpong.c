@@ -0,0 +1,118 @@
+/**
+ * @file      : queue_pingpong.c
+ * @brief     : 队列唤醒延迟测试
+ *              主线程和回显线程通过两个队列来回传递1字节数据(消费者阻塞等待), 测量每次往返的平均时间
+ *              不带参数时使用条件变量等待, 参数为futex时设置QUEUE_FLAG_FUTEX标志
+ *              编译: gcc -std=gnu11 -O2 -pthread -I.. queue_pingpong.c ../queue.c -o queue_pingpong
+ *              运行: ./queue_pingpong; ./queue_pingpong futex
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-16 23:30:00
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-16 huenrong        创建文件
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "queue.h"
+
+#define PINGPONG_QUEUE_SIZE 64    // 队列容量
+#define PINGPONG_ROUND_NUM 200000 // 往返次数
+
+static queue_t ping_queue; // 主线程写入, 回显线程读取
+static queue_t pong_queue; // 回显线程写入, 主线程读取
+
+/**
+ * @brief  获取当前时间(CLOCK_MONOTONIC时钟)
+ * @return 当前时间(单位: ns)
+ */
+static uint64_t pingpong_get_time_ns(void)
+{
+    struct timespec now = {0};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (((uint64_t)now.tv_sec * 1000000000ULL) + now.tv_nsec);
+}
+
+/**
+ * @brief  回显线程: 阻塞读取ping_queue, 原样写入pong_queue
+ * @param  arg: 输入参数, 未使用
+ * @return NULL
+ */
+static void *pingpong_echo_thread(void *arg)
+{
+    (void)arg;
+
+    uint8_t data = 0;
+    for (uint32_t i = 0; i < PINGPONG_ROUND_NUM; i++)
+    {
+        if (1 != queue_get_data(&ping_queue, &data, 1))
+        {
+            break;
+        }
+
+        queue_put_data(&pong_queue, &data, 1);
+    }
+
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    queue_attr_t attr;
+    queue_attr_init(&attr);
+    if ((argc > 1) && (0 == strcmp(argv[1], "futex")))
+    {
+        attr.flags |= QUEUE_FLAG_FUTEX;
+    }
+
+    if ((!queue_init_with_attr(&ping_queue, PINGPONG_QUEUE_SIZE, &attr)) ||
+        (!queue_init_with_attr(&pong_queue, PINGPONG_QUEUE_SIZE, &attr)))
+    {
+        printf("queue init failed\n");
+
+        return 1;
+    }
+
+    pthread_t echo_thread;
+    if (0 != pthread_create(&echo_thread, NULL, pingpong_echo_thread, NULL))
+    {
+        printf("pthread create failed\n");
+        queue_destroy(&ping_queue);
+        queue_destroy(&pong_queue);
+
+        return 1;
+    }
+
+    uint8_t data = 0;
+    uint64_t start_ns = pingpong_get_time_ns();
+    for (uint32_t i = 0; i < PINGPONG_ROUND_NUM; i++)
+    {
+        data = (uint8_t)i;
+        queue_put_data(&ping_queue, &data, 1);
+        if ((1 != queue_get_data(&pong_queue, &data, 1)) || ((uint8_t)i != data))
+        {
+            // 回显线程可能阻塞在队列上, 直接退出进程
+            printf("round %u failed\n", i);
+
+            return 1;
+        }
+    }
+    uint64_t elapsed_ns = (pingpong_get_time_ns() - start_ns);
+
+    pthread_join(echo_thread, NULL);
+    printf("%s: %.2f us per round trip\n", ((attr.flags & QUEUE_FLAG_FUTEX) ? "futex" : "cond"),
+           ((double)elapsed_ns / PINGPONG_ROUND_NUM / 1000));
+
+    queue_destroy(&ping_queue);
+    queue_destroy(&pong_queue);
+
+    return 0;
+}
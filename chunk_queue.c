@@ -0,0 +1,411 @@
+/**
+ * @file      : chunk_queue.c
+ * @brief     : Linux平台无界分块队列驱动源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-16 21:30:00
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-16 huenrong        创建文件
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#include "./chunk_queue.h"
+#include "./queue_sys.h"
+
+/**
+ * @brief  获取一个空数据块, 优先从空闲链表中取出(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @return 成功: 数据块
+ *         失败: NULL(内存不足)
+ */
+static chunk_queue_chunk_t *chunk_queue_alloc_chunk(chunk_queue_t *queue_name)
+{
+    chunk_queue_chunk_t *chunk = queue_name->free_chunks;
+    if (chunk)
+    {
+        queue_name->free_chunks = chunk->next;
+        queue_name->free_num--;
+    }
+    else
+    {
+        chunk = (chunk_queue_chunk_t *)malloc(sizeof(chunk_queue_chunk_t) + queue_name->chunk_size);
+        if (!chunk)
+        {
+            return NULL;
+        }
+    }
+
+    chunk->next = NULL;
+    chunk->head = chunk->tail = 0;
+
+    return chunk;
+}
+
+/**
+ * @brief  回收数据块, 空闲链表已满时直接释放(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  chunk     : 输入参数, 数据块
+ */
+static void chunk_queue_free_chunk(chunk_queue_t *queue_name, chunk_queue_chunk_t *chunk)
+{
+    // 只缓存少量空闲数据块, 数据量回落后内存随之释放
+    if (queue_name->free_num >= CHUNK_QUEUE_MAX_FREE_CHUNKS)
+    {
+        free(chunk);
+
+        return;
+    }
+
+    chunk->next = queue_name->free_chunks;
+    queue_name->free_chunks = chunk;
+    queue_name->free_num++;
+}
+
+/**
+ * @brief  从队列中读取数据, 读空的数据块放回空闲链表(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @return 实际获取个数
+ */
+static uint32_t chunk_queue_read_locked(chunk_queue_t *queue_name, uint8_t *data, const uint32_t data_len)
+{
+    uint32_t get_num = 0;
+    uint64_t used_size = queue_name->current_size;
+
+    while ((get_num < data_len) && (get_num < used_size))
+    {
+        chunk_queue_chunk_t *chunk = queue_name->head_chunk;
+        uint32_t copy_len = (chunk->tail - chunk->head);
+        if (copy_len > (data_len - get_num))
+        {
+            copy_len = (data_len - get_num);
+        }
+
+        memcpy(&data[get_num], &chunk->data[chunk->head], copy_len);
+        chunk->head += copy_len;
+        get_num += copy_len;
+
+        // 队头数据块已读空: 后面还有数据块时放回空闲链表, 否则原地复用
+        if (chunk->head == chunk->tail)
+        {
+            if (chunk->next)
+            {
+                queue_name->head_chunk = chunk->next;
+                chunk_queue_free_chunk(queue_name, chunk);
+            }
+            else
+            {
+                chunk->head = chunk->tail = 0;
+            }
+        }
+    }
+
+    __atomic_store_n(&queue_name->current_size, (used_size - get_num), __ATOMIC_RELAXED);
+
+    // 还有剩余数据, 继续唤醒下一个等待的消费者
+    if ((get_num > 0) && (get_num < used_size) && (queue_name->get_waiters > 0))
+    {
+        pthread_cond_signal(&queue_name->queue_cond);
+    }
+
+    return get_num;
+}
+
+/**
+ * @brief  从队列中获取数据, 队列为空时等待
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @param  end_time  : 输入参数, 超时结束时间(CLOCK_MONOTONIC时钟, 为NULL时一直等待)
+ * @return 成功: 实际获取个数
+ *         失败: -1
+ */
+static int chunk_queue_read_wait(chunk_queue_t *queue_name, uint8_t *data, const uint32_t data_len,
+                                 const struct timespec *end_time)
+{
+    pthread_mutex_lock(&queue_name->queue_mutex);
+
+    while (0 == queue_name->current_size)
+    {
+        int ret = 0;
+        queue_name->get_waiters++;
+        if (end_time)
+        {
+            ret = pthread_cond_timedwait(&queue_name->queue_cond, &queue_name->queue_mutex, end_time);
+        }
+        else
+        {
+            ret = pthread_cond_wait(&queue_name->queue_cond, &queue_name->queue_mutex);
+        }
+        queue_name->get_waiters--;
+
+        // 超时, 最后再检查一次
+        if ((ETIMEDOUT == ret) && (0 == queue_name->current_size))
+        {
+            pthread_mutex_unlock(&queue_name->queue_mutex);
+
+            return -1;
+        }
+    }
+
+    uint32_t get_num = chunk_queue_read_locked(queue_name, data, data_len);
+
+    pthread_mutex_unlock(&queue_name->queue_mutex);
+
+    return get_num;
+}
+
+/**
+ * @brief  初始化无界分块队列
+ * @param  queue_name: 输出参数, 队列名
+ * @param  chunk_size: 输入参数, 数据块大小(为0时使用CHUNK_QUEUE_DEFAULT_CHUNK_SIZE)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool chunk_queue_init(chunk_queue_t *queue_name, const uint32_t chunk_size)
+{
+    if ((!queue_name) || (chunk_size > (1U << 31)))
+    {
+        return false;
+    }
+
+    memset(queue_name, 0, sizeof(chunk_queue_t));
+
+    queue_name->chunk_size = ((chunk_size > 0) ? chunk_size : CHUNK_QUEUE_DEFAULT_CHUNK_SIZE);
+
+    // 队列中始终至少有一个数据块, 队头和队尾数据块相同时表示数据都在同一个数据块中
+    queue_name->head_chunk = queue_name->tail_chunk = chunk_queue_alloc_chunk(queue_name);
+    if (!queue_name->head_chunk)
+    {
+        return false;
+    }
+
+    pthread_mutex_init(&queue_name->queue_mutex, NULL);
+
+    // 超时等待使用CLOCK_MONOTONIC时钟, 不受系统时间调整影响
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&queue_name->queue_cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+
+    return true;
+}
+
+/**
+ * @brief  清空队列(数据块放回空闲链表)
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool chunk_queue_clear(chunk_queue_t *queue_name)
+{
+    if (!queue_name)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&queue_name->queue_mutex);
+
+    // 保留队头数据块, 其余数据块回收
+    chunk_queue_chunk_t *chunk = queue_name->head_chunk->next;
+    while (chunk)
+    {
+        chunk_queue_chunk_t *next = chunk->next;
+        chunk_queue_free_chunk(queue_name, chunk);
+        chunk = next;
+    }
+
+    queue_name->head_chunk->next = NULL;
+    queue_name->head_chunk->head = queue_name->head_chunk->tail = 0;
+    queue_name->tail_chunk = queue_name->head_chunk;
+    __atomic_store_n(&queue_name->current_size, 0, __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&queue_name->queue_mutex);
+
+    return true;
+}
+
+/**
+ * @brief  获取队列当前元素个数
+ * @param  queue_name: 输入参数, 队列名
+ * @return 队列当前元素个数
+ */
+uint64_t chunk_queue_get_current_size(const chunk_queue_t *queue_name)
+{
+    if (!queue_name)
+    {
+        return 0;
+    }
+
+    return __atomic_load_n(&queue_name->current_size, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief  写入数据到队列(空间不足时追加数据块, 不会截断)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return 成功: 实际插入个数(只有内存不足时小于待插入数据长度)
+ *         失败: -1
+ */
+int chunk_queue_put_data(chunk_queue_t *queue_name, const uint8_t *data, const uint32_t data_len)
+{
+    // 实际插入个数
+    uint32_t put_num = 0;
+
+    if ((!queue_name) || (!data) || (!data_len))
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&queue_name->queue_mutex);
+
+    uint64_t used_size = queue_name->current_size;
+
+    while (put_num < data_len)
+    {
+        // 队尾数据块已写满, 追加一个数据块
+        chunk_queue_chunk_t *chunk = queue_name->tail_chunk;
+        if (chunk->tail == queue_name->chunk_size)
+        {
+            chunk_queue_chunk_t *new_chunk = chunk_queue_alloc_chunk(queue_name);
+            if (!new_chunk)
+            {
+                break;
+            }
+
+            chunk->next = new_chunk;
+            queue_name->tail_chunk = new_chunk;
+            chunk = new_chunk;
+        }
+
+        uint32_t copy_len = (queue_name->chunk_size - chunk->tail);
+        if (copy_len > (data_len - put_num))
+        {
+            copy_len = (data_len - put_num);
+        }
+
+        memcpy(&chunk->data[chunk->tail], &data[put_num], copy_len);
+        chunk->tail += copy_len;
+        put_num += copy_len;
+    }
+
+    __atomic_store_n(&queue_name->current_size, (used_size + put_num), __ATOMIC_RELAXED);
+
+    // 只有存在等待的消费者, 且队列由空变为非空时才唤醒
+    if ((put_num > 0) && (0 == used_size) && (queue_name->get_waiters > 0))
+    {
+        pthread_cond_signal(&queue_name->queue_cond);
+    }
+
+    pthread_mutex_unlock(&queue_name->queue_mutex);
+
+    return ((put_num > 0) ? (int)put_num : -1);
+}
+
+/**
+ * @brief  阻塞方式从队列中获取数据
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @return 成功: 实际获取个数
+ *         失败: -1
+ */
+int chunk_queue_get_data(chunk_queue_t *queue_name, uint8_t *data, const uint32_t data_len)
+{
+    if ((!queue_name) || (!data) || (!data_len))
+    {
+        return -1;
+    }
+
+    return chunk_queue_read_wait(queue_name, data, data_len, NULL);
+}
+
+/**
+ * @brief  超时方式从队列中获取数据(超时时间为0, 直接从队列获取数据)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际获取个数
+ *         失败: -1
+ */
+int chunk_queue_get_data_with_timeout(chunk_queue_t *queue_name, uint8_t *data, const uint32_t data_len,
+                                      const uint32_t timeout)
+{
+    if ((!queue_name) || (!data) || (!data_len))
+    {
+        return -1;
+    }
+
+    if (0 == timeout)
+    {
+        pthread_mutex_lock(&queue_name->queue_mutex);
+
+        uint32_t get_num = chunk_queue_read_locked(queue_name, data, data_len);
+
+        pthread_mutex_unlock(&queue_name->queue_mutex);
+
+        return get_num;
+    }
+
+    // 等待信号的结束时间
+    struct timespec end_time = {0};
+    queue_sys_deadline_after_ms(&end_time, timeout);
+
+    return chunk_queue_read_wait(queue_name, data, data_len, &end_time);
+}
+
+/**
+ * @brief  判断队列是否为空
+ * @param  queue_name: 输入参数, 队列名
+ * @return true : 队列为空
+ * @return false: 队列非空
+ */
+bool chunk_queue_is_empty(const chunk_queue_t *queue_name)
+{
+    return ((!chunk_queue_get_current_size(queue_name)) ? true : false);
+}
+
+/**
+ * @brief  销毁队列(释放全部数据块)
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool chunk_queue_destroy(chunk_queue_t *queue_name)
+{
+    if (!queue_name)
+    {
+        return false;
+    }
+
+    chunk_queue_chunk_t *lists[2] = {queue_name->head_chunk, queue_name->free_chunks};
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        chunk_queue_chunk_t *chunk = lists[i];
+        while (chunk)
+        {
+            chunk_queue_chunk_t *next = chunk->next;
+            free(chunk);
+            chunk = next;
+        }
+    }
+
+    pthread_mutex_destroy(&queue_name->queue_mutex);
+    pthread_cond_destroy(&queue_name->queue_cond);
+
+    memset(queue_name, 0, sizeof(chunk_queue_t));
+
+    return true;
+}
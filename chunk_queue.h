@@ -0,0 +1,133 @@
+/**
+ * @file      : chunk_queue.h
+ * @brief     : Linux平台无界分块队列驱动头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-16 21:30:00
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-16 huenrong        创建文件
+ *
+ */
+
+#ifndef __CHUNK_QUEUE_H
+#define __CHUNK_QUEUE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#define CHUNK_QUEUE_DEFAULT_CHUNK_SIZE (64 * 1024) // 默认数据块大小
+
+#ifndef CHUNK_QUEUE_MAX_FREE_CHUNKS
+#define CHUNK_QUEUE_MAX_FREE_CHUNKS 4 // 空闲链表最多缓存的数据块个数, 超出的数据块直接释放
+#endif
+
+// 数据块结构体
+typedef struct chunk_queue_chunk
+{
+    struct chunk_queue_chunk *next; // 下一个数据块
+    uint32_t head;                  // 块内读取位置
+    uint32_t tail;                  // 块内写入位置
+    uint8_t data[];                 // 块内数据(大小为chunk_size)
+} chunk_queue_chunk_t;
+
+// 无界分块队列结构体
+// 数据保存在固定大小的数据块链表中, 生产者写满队尾数据块后追加新的数据块, 消费者读空队头数据块后放回空闲链表
+// 写入不会因队列满而截断, 内存占用随队列中的数据量增减
+typedef struct
+{
+    chunk_queue_chunk_t *head_chunk;  // 队头数据块(消费者读取)
+    chunk_queue_chunk_t *tail_chunk;  // 队尾数据块(生产者写入)
+    chunk_queue_chunk_t *free_chunks; // 空闲数据块链表
+    uint32_t free_num;                // 空闲数据块个数
+    uint32_t chunk_size;              // 数据块大小
+    uint64_t current_size;            // 队列当前大小
+    pthread_mutex_t queue_mutex;      // 队列互斥锁
+    pthread_cond_t queue_cond;        // 队列条件变量(队列非空)
+    uint32_t get_waiters;             // 等待数据的消费者个数
+} chunk_queue_t;
+
+/**
+ * @brief  初始化无界分块队列
+ * @param  queue_name: 输出参数, 队列名
+ * @param  chunk_size: 输入参数, 数据块大小(为0时使用CHUNK_QUEUE_DEFAULT_CHUNK_SIZE)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool chunk_queue_init(chunk_queue_t *queue_name, const uint32_t chunk_size);
+
+/**
+ * @brief  清空队列(数据块放回空闲链表)
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool chunk_queue_clear(chunk_queue_t *queue_name);
+
+/**
+ * @brief  获取队列当前元素个数
+ * @param  queue_name: 输入参数, 队列名
+ * @return 队列当前元素个数
+ */
+uint64_t chunk_queue_get_current_size(const chunk_queue_t *queue_name);
+
+/**
+ * @brief  写入数据到队列(空间不足时追加数据块, 不会截断)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return 成功: 实际插入个数(只有内存不足时小于待插入数据长度)
+ *         失败: -1
+ */
+int chunk_queue_put_data(chunk_queue_t *queue_name, const uint8_t *data, const uint32_t data_len);
+
+/**
+ * @brief  阻塞方式从队列中获取数据
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @return 成功: 实际获取个数
+ *         失败: -1
+ */
+int chunk_queue_get_data(chunk_queue_t *queue_name, uint8_t *data, const uint32_t data_len);
+
+/**
+ * @brief  超时方式从队列中获取数据(超时时间为0, 直接从队列获取数据)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际获取个数
+ *         失败: -1
+ */
+int chunk_queue_get_data_with_timeout(chunk_queue_t *queue_name, uint8_t *data, const uint32_t data_len,
+                                      const uint32_t timeout);
+
+/**
+ * @brief  判断队列是否为空
+ * @param  queue_name: 输入参数, 队列名
+ * @return true : 队列为空
+ * @return false: 队列非空
+ */
+bool chunk_queue_is_empty(const chunk_queue_t *queue_name);
+
+/**
+ * @brief  销毁队列(释放全部数据块)
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool chunk_queue_destroy(chunk_queue_t *queue_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CHUNK_QUEUE_H
@@ -0,0 +1,406 @@
+/**
+ * @file      : mpmc_queue.c
+ * @brief     : Linux平台多生产者多消费者无锁队列驱动源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-16 11:00:00
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-16 huenrong        创建文件
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./mpmc_queue.h"
+#include "./queue_sys.h"
+
+/**
+ * @brief  获取槽位的序号地址
+ * @param  queue_name: 输入参数, 队列名
+ * @param  pos       : 输入参数, 读写位置
+ * @return 槽位的序号地址(元素紧跟在序号之后)
+ */
+static inline uint32_t *mpmc_queue_get_cell(const mpmc_queue_t *queue_name, const uint32_t pos)
+{
+    return (uint32_t *)&queue_name->cells[(size_t)(pos & queue_name->mask) * queue_name->cell_size];
+}
+
+/**
+ * @brief  写入一个元素到队列(不阻塞)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入元素
+ * @return true : 成功
+ * @return false: 队列已满
+ */
+static bool mpmc_queue_push(mpmc_queue_t *queue_name, const uint8_t *data)
+{
+    uint32_t *cell = NULL;
+    uint32_t pos = __atomic_load_n(&queue_name->enqueue_pos, __ATOMIC_RELAXED);
+
+    while (true)
+    {
+        cell = mpmc_queue_get_cell(queue_name, pos);
+        uint32_t seq = __atomic_load_n(cell, __ATOMIC_ACQUIRE);
+        int32_t diff = (int32_t)(seq - pos);
+
+        // 槽位空闲, 抢占写入位置
+        if (0 == diff)
+        {
+            if (__atomic_compare_exchange_n(&queue_name->enqueue_pos, &pos, (pos + 1), true, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        // 槽位中的元素还未被消费, 队列已满
+        else if (diff < 0)
+        {
+            return false;
+        }
+        // 写入位置已被其他生产者抢占
+        else
+        {
+            pos = __atomic_load_n(&queue_name->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    memcpy(&cell[1], data, queue_name->element_size);
+
+    // 发布槽位, 序号等于pos + 1表示槽位中有数据
+    __atomic_store_n(cell, (pos + 1), __ATOMIC_RELEASE);
+
+    return true;
+}
+
+/**
+ * @brief  从队列中读取一个元素(不阻塞)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的元素(为NULL时丢弃元素)
+ * @return true : 成功
+ * @return false: 队列为空
+ */
+static bool mpmc_queue_pop(mpmc_queue_t *queue_name, uint8_t *data)
+{
+    uint32_t *cell = NULL;
+    uint32_t pos = __atomic_load_n(&queue_name->dequeue_pos, __ATOMIC_RELAXED);
+
+    while (true)
+    {
+        cell = mpmc_queue_get_cell(queue_name, pos);
+        uint32_t seq = __atomic_load_n(cell, __ATOMIC_ACQUIRE);
+        int32_t diff = (int32_t)(seq - (pos + 1));
+
+        // 槽位中有数据, 抢占读取位置
+        if (0 == diff)
+        {
+            if (__atomic_compare_exchange_n(&queue_name->dequeue_pos, &pos, (pos + 1), true, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        // 槽位还未写入, 队列为空
+        else if (diff < 0)
+        {
+            return false;
+        }
+        // 读取位置已被其他消费者抢占
+        else
+        {
+            pos = __atomic_load_n(&queue_name->dequeue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    if (data)
+    {
+        memcpy(data, &cell[1], queue_name->element_size);
+    }
+
+    // 释放槽位, 序号前进一圈供下一轮生产者使用
+    __atomic_store_n(cell, (pos + queue_name->total_size), __ATOMIC_RELEASE);
+
+    return true;
+}
+
+/**
+ * @brief  从队列中读取多个元素(不阻塞)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的元素
+ * @param  data_num  : 输入参数, 指定获取元素个数
+ * @return 实际获取元素个数
+ */
+static uint32_t mpmc_queue_read(mpmc_queue_t *queue_name, uint8_t *data, const uint32_t data_num)
+{
+    uint32_t get_num = 0;
+
+    while ((get_num < data_num) && (mpmc_queue_pop(queue_name, &data[(size_t)get_num * queue_name->element_size])))
+    {
+        get_num++;
+    }
+
+    return get_num;
+}
+
+/**
+ * @brief  从队列中获取元素, 队列为空时休眠等待
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的元素
+ * @param  data_num  : 输入参数, 指定获取元素个数
+ * @param  deadline  : 输入参数, 超时结束时间(CLOCK_MONOTONIC时钟, 为NULL时一直等待)
+ * @return 成功: 实际获取元素个数
+ *         失败: -1
+ */
+static int mpmc_queue_read_wait(mpmc_queue_t *queue_name, uint8_t *data, const uint32_t data_num,
+                                const struct timespec *deadline)
+{
+    while (true)
+    {
+        uint32_t get_num = mpmc_queue_read(queue_name, data, data_num);
+        if (get_num > 0)
+        {
+            return get_num;
+        }
+
+        // 先记录唤醒序号并登记为休眠者, 再检查一次队列
+        // 生产者写入后发现有休眠者会修改唤醒序号, futex因序号不一致立即返回, 不会丢失唤醒
+        uint32_t seq = __atomic_load_n(&queue_name->put_seq, __ATOMIC_ACQUIRE);
+        __atomic_add_fetch(&queue_name->waiters, 1, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        get_num = mpmc_queue_read(queue_name, data, data_num);
+        if (get_num > 0)
+        {
+            __atomic_sub_fetch(&queue_name->waiters, 1, __ATOMIC_RELAXED);
+
+            return get_num;
+        }
+
+        int ret = queue_sys_futex_wait(&queue_name->put_seq, seq, deadline);
+
+        __atomic_sub_fetch(&queue_name->waiters, 1, __ATOMIC_RELAXED);
+
+        // 超时, 最后再尝试读取一次
+        if (ETIMEDOUT == ret)
+        {
+            get_num = mpmc_queue_read(queue_name, data, data_num);
+
+            return ((get_num > 0) ? (int)get_num : -1);
+        }
+    }
+}
+
+/**
+ * @brief  初始化多生产者多消费者队列
+ * @param  queue_name  : 输出参数, 队列名
+ * @param  element_size: 输入参数, 单个元素的大小
+ * @param  queue_size  : 输入参数, 队列最小容量(元素个数, 向上取整为2的幂, 不能超过2^31)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool mpmc_queue_init(mpmc_queue_t *queue_name, const uint32_t element_size, const uint32_t queue_size)
+{
+    if ((!queue_name) || (!element_size) || (element_size > (UINT32_MAX / 2)) || (!queue_size) ||
+        (queue_size > (1U << 31)))
+    {
+        return false;
+    }
+
+    // 容量向上取整为2的幂
+    uint32_t len = 1;
+    while (len < queue_size)
+    {
+        len <<= 1;
+    }
+
+    memset(queue_name, 0, sizeof(mpmc_queue_t));
+
+    // 槽位大小按序号对齐, 保证每个槽位的序号都可以原子访问
+    queue_name->element_size = element_size;
+    queue_name->cell_size = ((sizeof(uint32_t) + element_size + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1));
+
+    queue_name->cells = (uint8_t *)malloc((size_t)len * queue_name->cell_size);
+    if (!queue_name->cells)
+    {
+        return false;
+    }
+
+    queue_name->total_size = len;
+    queue_name->mask = (len - 1);
+
+    // 槽位初始序号等于其下标, 表示可写
+    for (uint32_t i = 0; i < len; i++)
+    {
+        *mpmc_queue_get_cell(queue_name, i) = i;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  清空队列
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool mpmc_queue_clear(mpmc_queue_t *queue_name)
+{
+    if (!queue_name)
+    {
+        return false;
+    }
+
+    // 逐个丢弃元素, 可与其他生产者和消费者并发执行
+    while (mpmc_queue_pop(queue_name, NULL))
+    {
+    }
+
+    return true;
+}
+
+/**
+ * @brief  获取队列当前元素个数(并发读写时为近似值)
+ * @param  queue_name: 输入参数, 队列名
+ * @return 队列当前元素个数
+ */
+uint32_t mpmc_queue_get_current_size(const mpmc_queue_t *queue_name)
+{
+    if (!queue_name)
+    {
+        return 0;
+    }
+
+    uint32_t dequeue_pos = __atomic_load_n(&queue_name->dequeue_pos, __ATOMIC_ACQUIRE);
+    uint32_t enqueue_pos = __atomic_load_n(&queue_name->enqueue_pos, __ATOMIC_ACQUIRE);
+    int32_t size = (int32_t)(enqueue_pos - dequeue_pos);
+
+    // 两个位置不是同时读取, 需要限制在有效范围内
+    if (size < 0)
+    {
+        return 0;
+    }
+    if ((uint32_t)size > queue_name->total_size)
+    {
+        return queue_name->total_size;
+    }
+
+    return (uint32_t)size;
+}
+
+/**
+ * @brief  写入元素到队列
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入元素
+ * @param  data_num  : 输入参数, 待插入元素个数
+ * @return 成功: 实际插入元素个数
+ *         失败: -1
+ */
+int mpmc_queue_put_data(mpmc_queue_t *queue_name, const void *data, const uint32_t data_num)
+{
+    // 实际插入个数
+    uint32_t put_num = 0;
+
+    if ((!queue_name) || (!data) || (!data_num))
+    {
+        return -1;
+    }
+
+    const uint8_t *elements = (const uint8_t *)data;
+    while ((put_num < data_num) &&
+           (mpmc_queue_push(queue_name, &elements[(size_t)put_num * queue_name->element_size])))
+    {
+        put_num++;
+    }
+
+    // 只有存在休眠的消费者时才修改唤醒序号并进入内核
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if ((put_num > 0) && (__atomic_load_n(&queue_name->waiters, __ATOMIC_RELAXED) > 0))
+    {
+        __atomic_add_fetch(&queue_name->put_seq, 1, __ATOMIC_RELEASE);
+
+        queue_sys_futex_wake(&queue_name->put_seq, (int)((put_num < INT_MAX) ? put_num : INT_MAX));
+    }
+
+    return put_num;
+}
+
+/**
+ * @brief  阻塞方式从队列中获取元素
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的元素
+ * @param  data_num  : 输入参数, 指定获取元素个数
+ * @return 成功: 实际获取元素个数
+ *         失败: -1
+ */
+int mpmc_queue_get_data(mpmc_queue_t *queue_name, void *data, const uint32_t data_num)
+{
+    if ((!queue_name) || (!data) || (!data_num))
+    {
+        return -1;
+    }
+
+    return mpmc_queue_read_wait(queue_name, (uint8_t *)data, data_num, NULL);
+}
+
+/**
+ * @brief  超时方式从队列中获取元素(超时时间为0, 直接从队列获取元素)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的元素
+ * @param  data_num  : 输入参数, 指定获取元素个数
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际获取元素个数
+ *         失败: -1
+ */
+int mpmc_queue_get_data_with_timeout(mpmc_queue_t *queue_name, void *data, const uint32_t data_num,
+                                     const uint32_t timeout)
+{
+    if ((!queue_name) || (!data) || (!data_num))
+    {
+        return -1;
+    }
+
+    if (0 == timeout)
+    {
+        return mpmc_queue_read(queue_name, (uint8_t *)data, data_num);
+    }
+
+    // 等待信号的结束时间
+    struct timespec end_time = {0};
+    queue_sys_deadline_after_ms(&end_time, timeout);
+
+    return mpmc_queue_read_wait(queue_name, (uint8_t *)data, data_num, &end_time);
+}
+
+/**
+ * @brief  判断队列是否为空
+ * @param  queue_name: 输入参数, 队列名
+ * @return true : 队列为空
+ * @return false: 队列非空
+ */
+bool mpmc_queue_is_empty(const mpmc_queue_t *queue_name)
+{
+    return ((!mpmc_queue_get_current_size(queue_name)) ? true : false);
+}
+
+/**
+ * @brief  销毁队列
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool mpmc_queue_destroy(mpmc_queue_t *queue_name)
+{
+    if (!queue_name)
+    {
+        return false;
+    }
+
+    free(queue_name->cells);
+
+    memset(queue_name, 0, sizeof(mpmc_queue_t));
+
+    return true;
+}
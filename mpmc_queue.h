@@ -0,0 +1,128 @@
+/**
+ * @file      : mpmc_queue.h
+ * @brief     : Linux平台多生产者多消费者无锁队列驱动头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-16 11:00:00
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-16 huenrong        创建文件
+ *
+ */
+
+#ifndef __MPMC_QUEUE_H
+#define __MPMC_QUEUE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef QUEUE_CACHE_LINE_SIZE
+#define QUEUE_CACHE_LINE_SIZE 64 // 缓存行大小
+#endif
+
+// 多生产者多消费者无锁队列结构体
+// 队列元素为固定大小的记录, 每个槽位带一个序号, 生产者和消费者通过序号判断槽位是否可用
+typedef struct
+{
+    // 只读区
+    uint8_t *cells;        // 指向槽位数组的指针(每个槽位: 4字节序号 + 元素)
+    uint32_t cell_size;    // 单个槽位的大小
+    uint32_t element_size; // 单个元素的大小
+    uint32_t total_size;   // 槽位个数(2的幂)
+    uint32_t mask;         // 下标掩码(total_size - 1)
+
+    // 生产者区
+    uint32_t enqueue_pos __attribute__((aligned(QUEUE_CACHE_LINE_SIZE))); // 下一个写入位置(自由递增)
+
+    // 消费者区
+    uint32_t dequeue_pos __attribute__((aligned(QUEUE_CACHE_LINE_SIZE))); // 下一个读取位置(自由递增)
+
+    // 阻塞等待区
+    uint32_t put_seq __attribute__((aligned(QUEUE_CACHE_LINE_SIZE))); // 唤醒序号(futex等待地址)
+    uint32_t waiters;                                                 // 休眠的消费者个数
+} mpmc_queue_t;
+
+/**
+ * @brief  初始化多生产者多消费者队列
+ * @param  queue_name  : 输出参数, 队列名
+ * @param  element_size: 输入参数, 单个元素的大小
+ * @param  queue_size  : 输入参数, 队列最小容量(元素个数, 向上取整为2的幂, 不能超过2^31)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool mpmc_queue_init(mpmc_queue_t *queue_name, const uint32_t element_size, const uint32_t queue_size);
+
+/**
+ * @brief  清空队列
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool mpmc_queue_clear(mpmc_queue_t *queue_name);
+
+/**
+ * @brief  获取队列当前元素个数(并发读写时为近似值)
+ * @param  queue_name: 输入参数, 队列名
+ * @return 队列当前元素个数
+ */
+uint32_t mpmc_queue_get_current_size(const mpmc_queue_t *queue_name);
+
+/**
+ * @brief  写入元素到队列
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入元素
+ * @param  data_num  : 输入参数, 待插入元素个数
+ * @return 成功: 实际插入元素个数
+ *         失败: -1
+ */
+int mpmc_queue_put_data(mpmc_queue_t *queue_name, const void *data, const uint32_t data_num);
+
+/**
+ * @brief  阻塞方式从队列中获取元素
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的元素
+ * @param  data_num  : 输入参数, 指定获取元素个数
+ * @return 成功: 实际获取元素个数
+ *         失败: -1
+ */
+int mpmc_queue_get_data(mpmc_queue_t *queue_name, void *data, const uint32_t data_num);
+
+/**
+ * @brief  超时方式从队列中获取元素(超时时间为0, 直接从队列获取元素)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的元素
+ * @param  data_num  : 输入参数, 指定获取元素个数
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际获取元素个数
+ *         失败: -1
+ */
+int mpmc_queue_get_data_with_timeout(mpmc_queue_t *queue_name, void *data, const uint32_t data_num,
+                                     const uint32_t timeout);
+
+/**
+ * @brief  判断队列是否为空
+ * @param  queue_name: 输入参数, 队列名
+ * @return true : 队列为空
+ * @return false: 队列非空
+ */
+bool mpmc_queue_is_empty(const mpmc_queue_t *queue_name);
+
+/**
+ * @brief  销毁队列
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool mpmc_queue_destroy(mpmc_queue_t *queue_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MPMC_QUEUE_H
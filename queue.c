@@ -13,270 +13,3566 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <errno.h>
+#include <string.h>
 #include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/file.h>
 
 #include "./queue.h"
+#include "./queue_sys.h"
+
+#define QUEUE_SHARED_MAGIC 0x51554555  // 进程间共享队列初始化完成标志
+#define QUEUE_PERSIST_MAGIC 0x51554550 // 持久化队列文件标志
+#define QUEUE_CHECKSUM_LEN 4           // 持久化队列消息校验和长度
+#define QUEUE_CHECKSUM_INIT 2166136261U // 校验和初始值(FNV-1a)
+
+// 进程间共享队列和持久化队列的内存布局: 共享头部之后紧跟缓冲区
+typedef struct
+{
+    queue_t queue;                   // 队列(必须是第一个成员, 队列指针即共享内存首地址)
+    uint32_t magic;                  // 初始化完成标志, 创建进程初始化完成后才写入
+    uint32_t map_size;               // 共享内存大小
+    int lock_fd;                     // 持久化队列的文件描述符(持有文件锁, 每次打开时重新设置)
+    queue_sync_policy_t sync_policy; // 持久化队列同步策略(每次打开时重新设置)
+    uint32_t sync_interval;          // 持久化队列同步间隔(单位: ms)
+    uint64_t last_sync_ns;           // 持久化队列上次同步的时间(单位: ns)
+} queue_shared_t;
+
+// 缓冲区相对于共享内存首地址的偏移(按缓存行对齐)
+#define QUEUE_SHARED_DATA_OFFSET ((sizeof(queue_shared_t) + 63) & ~((size_t)63))
+
+/**
+ * @brief  获取队列已用空间(调用者需持有队列互斥锁)
+ * @param  queue_name: 输入参数, 队列名
+ * @return 队列已用空间
+ */
+static inline uint32_t queue_get_used_size(const queue_t *queue_name)
+{
+    // 2的幂模式下头尾指针自由递增, 差值即为已用空间(溢出回绕后依然成立)
+    if (queue_name->flags & QUEUE_FLAG_POW2)
+    {
+        return (queue_name->tail - queue_name->head);
+    }
+
+    return queue_name->current_size;
+}
+
+/**
+ * @brief  不加锁读取队列已用空间(只用于自旋判断, 结果需在加锁后再次确认)
+ * @param  queue_name: 输入参数, 队列名
+ * @return 队列已用空间
+ */
+static inline uint32_t queue_peek_used_size(const queue_t *queue_name)
+{
+    if (queue_name->flags & QUEUE_FLAG_POW2)
+    {
+        return (__atomic_load_n(&queue_name->tail, __ATOMIC_RELAXED) -
+                __atomic_load_n(&queue_name->head, __ATOMIC_RELAXED));
+    }
+
+    return __atomic_load_n(&queue_name->current_size, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief  不加锁读取消费者可读取的长度(只用于自旋和队列集合判断, 结果需在加锁后再次确认)
+ * @param  queue_name: 输入参数, 队列名
+ * @return 可读取的长度
+ */
+static inline uint32_t queue_peek_readable_size(const queue_t *queue_name)
+{
+    // 有未释放的消费者视图时, 其他读取需等待释放
+    if (__atomic_load_n(&queue_name->get_viewed, __ATOMIC_RELAXED) > 0)
+    {
+        return 0;
+    }
+
+    return queue_peek_used_size(queue_name);
+}
+
+/**
+ * @brief  获取队列容量
+ * @param  queue_name: 输入参数, 队列名
+ * @return 队列容量
+ */
+static inline uint32_t queue_get_capacity(const queue_t *queue_name)
+{
+    // 普通模式下缓冲区中有一个间隔元素不可用
+    if (queue_name->flags & QUEUE_FLAG_POW2)
+    {
+        return queue_name->total_size;
+    }
+
+    return (queue_name->total_size - 1);
+}
+
+/**
+ * @brief  获取队列剩余空间(调用者需持有队列互斥锁)
+ * @param  queue_name: 输入参数, 队列名
+ * @return 队列剩余空间
+ */
+static inline uint32_t queue_get_free_size(const queue_t *queue_name)
+{
+    return (queue_get_capacity(queue_name) - queue_get_used_size(queue_name));
+}
+
+/**
+ * @brief  获取读写的最小单位
+ * @param  queue_name: 输入参数, 队列名
+ * @return 固定大小元素队列为元素大小, 其他队列为1
+ */
+static inline uint32_t queue_get_unit_size(const queue_t *queue_name)
+{
+    return ((queue_name->element_size > 0) ? queue_name->element_size : 1);
+}
+
+/**
+ * @brief  获取队列可以达到的最大容量
+ * @param  queue_name: 输入参数, 队列名
+ * @return 自动调整容量的队列为自动扩容的最大容量, 其他队列为当前容量
+ */
+static inline uint32_t queue_get_max_capacity(const queue_t *queue_name)
+{
+    uint32_t capacity = queue_get_capacity(queue_name);
+    uint64_t max_capacity = ((uint64_t)queue_name->max_size * queue_get_unit_size(queue_name));
+
+    return ((max_capacity > capacity) ? (uint32_t)max_capacity : capacity);
+}
+
+/**
+ * @brief  判断队列是否可以使用字节流接口
+ * @param  queue_name: 输入参数, 队列名
+ * @return true : 字节流队列
+ * @return false: 消息模式队列或固定大小元素队列
+ */
+static inline bool queue_is_byte_stream(const queue_t *queue_name)
+{
+    return ((!(queue_name->flags & QUEUE_FLAG_MSG)) && (0 == queue_name->element_size));
+}
+
+/**
+ * @brief  获取缓冲区首地址
+ * @param  queue_name: 输入参数, 队列名
+ * @return 缓冲区首地址
+ */
+static inline uint8_t *queue_get_buffer(const queue_t *queue_name)
+{
+    // 进程间共享队列在各进程中的映射地址不同, 持久化队列每次打开的映射地址不同, 缓冲区按相对于队列的偏移计算
+    if (queue_name->flags & (QUEUE_FLAG_SHARED | QUEUE_FLAG_PERSIST))
+    {
+        return ((uint8_t *)queue_name + QUEUE_SHARED_DATA_OFFSET);
+    }
+
+    return queue_name->data;
+}
+
+/**
+ * @brief  加锁队列
+ * @param  queue_name: 输出参数, 队列名
+ */
+static inline void queue_lock(queue_t *queue_name)
+{
+    // 进程间共享队列使用健壮互斥锁, 持有锁的进程退出后, 由下一个加锁的进程恢复互斥锁
+    if (EOWNERDEAD == pthread_mutex_lock(&queue_name->queue_mutex))
+    {
+        pthread_mutex_consistent(&queue_name->queue_mutex);
+    }
+}
+
+/**
+ * @brief  在条件变量上等待(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  cond      : 输入参数, 条件变量
+ * @param  end_time  : 输入参数, 超时结束时间(为NULL时一直等待)
+ * @return 0        : 被唤醒(调用者需重新检查条件)
+ * @return ETIMEDOUT: 超时
+ */
+static inline int queue_cond_wait(queue_t *queue_name, pthread_cond_t *cond, const struct timespec *end_time)
+{
+    int ret = 0;
+    if (end_time)
+    {
+        ret = pthread_cond_timedwait(cond, &queue_name->queue_mutex, end_time);
+    }
+    else
+    {
+        ret = pthread_cond_wait(cond, &queue_name->queue_mutex);
+    }
+
+    if (EOWNERDEAD == ret)
+    {
+        pthread_mutex_consistent(&queue_name->queue_mutex);
+        ret = 0;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  将头尾指针转换为缓冲区下标
+ * @param  queue_name: 输入参数, 队列名
+ * @param  pos       : 输入参数, 头指针或尾指针
+ * @return 缓冲区下标
+ */
+static inline uint32_t queue_get_index(const queue_t *queue_name, const uint32_t pos)
+{
+    if (queue_name->flags & QUEUE_FLAG_POW2)
+    {
+        return (pos & queue_name->mask);
+    }
+
+    return pos;
+}
+
+/**
+ * @brief  头尾指针向后移动, 使用掩码或减法代替取模
+ * @param  queue_name: 输入参数, 队列名
+ * @param  pos       : 输入参数, 头指针或尾指针
+ * @param  len       : 输入参数, 移动长度
+ * @return 移动后的指针
+ */
+static inline uint32_t queue_advance(const queue_t *queue_name, uint32_t pos, const uint32_t len)
+{
+    pos += len;
+
+    // 2的幂模式下指针自由递增, 使用时再取掩码
+    if ((!(queue_name->flags & QUEUE_FLAG_POW2)) && (pos >= queue_name->total_size))
+    {
+        pos -= queue_name->total_size;
+    }
+
+    return pos;
+}
+
+/**
+ * @brief  获取从指定位置开始的缓冲区片段, 最多两段(调用者需持有队列互斥锁)
+ * @param  queue_name: 输入参数, 队列名
+ * @param  pos       : 输入参数, 头指针或尾指针
+ * @param  len       : 输入参数, 片段总长度
+ * @param  seg1      : 输出参数, 第一段: 指定位置到缓冲区末尾
+ * @param  seg2      : 输出参数, 第二段: 回绕到缓冲区开头(不回绕时长度为0)
+ */
+static void queue_get_segments(const queue_t *queue_name, const uint32_t pos, const uint32_t len,
+                               queue_segment_t *seg1, queue_segment_t *seg2)
+{
+    uint32_t index = queue_get_index(queue_name, pos);
+
+    // 镜像映射模式下缓冲区之后紧跟着缓冲区本身的映射, 跨越末尾的数据也是连续的
+    if (queue_name->flags & QUEUE_FLAG_MIRROR)
+    {
+        seg1->data = &queue_get_buffer(queue_name)[index];
+        seg1->len = len;
+        seg2->data = queue_get_buffer(queue_name);
+        seg2->len = 0;
+
+        return;
+    }
+
+    uint32_t first_len = (queue_name->total_size - index);
+    if (first_len > len)
+    {
+        first_len = len;
+    }
+
+    uint8_t *buffer = queue_get_buffer(queue_name);
+    seg1->data = &buffer[index];
+    seg1->len = first_len;
+    seg2->data = buffer;
+    seg2->len = (len - first_len);
+}
+
+/**
+ * @brief  队尾指针向后移动(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  len       : 输入参数, 移动长度
+ */
+static inline void queue_advance_tail(queue_t *queue_name, const uint32_t len)
+{
+    // 数据拷贝完成后才发布尾指针, release保证拷贝不会被重排到指针更新之后
+    // 持久化队列的进程在任意位置退出, 文件中的尾指针都不会指向未写入的数据
+    __atomic_store_n(&queue_name->tail, queue_advance(queue_name, queue_name->tail, len), __ATOMIC_RELEASE);
+
+    // 元素个数增加(2的幂模式下由头尾指针推导)
+    if (!(queue_name->flags & QUEUE_FLAG_POW2))
+    {
+        __atomic_store_n(&queue_name->current_size, (queue_name->current_size + len), __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief  队头指针向后移动(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  len       : 输入参数, 移动长度
+ */
+static inline void queue_advance_head(queue_t *queue_name, const uint32_t len)
+{
+    // 数据拷贝完成后才发布头指针, 生产者才能复用这段空间
+    __atomic_store_n(&queue_name->head, queue_advance(queue_name, queue_name->head, len), __ATOMIC_RELEASE);
+
+    // 元素个数减小(2的幂模式下由头尾指针推导)
+    if (!(queue_name->flags & QUEUE_FLAG_POW2))
+    {
+        __atomic_store_n(&queue_name->current_size, (queue_name->current_size - len), __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief  拷贝数据到指定位置, 最多分两段拷贝, 不移动头尾指针(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  pos       : 输入参数, 写入位置(尾指针或尾指针之后的位置)
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ */
+static void queue_write_at(queue_t *queue_name, const uint32_t pos, const uint8_t *data, const uint32_t data_len)
+{
+    queue_segment_t seg1 = {0};
+    queue_segment_t seg2 = {0};
+    queue_get_segments(queue_name, pos, data_len, &seg1, &seg2);
+
+    memcpy(seg1.data, data, seg1.len);
+    if (seg2.len > 0)
+    {
+        memcpy(seg2.data, &data[seg1.len], seg2.len);
+    }
+}
+
+/**
+ * @brief  从指定位置拷贝数据, 最多分两段拷贝, 不移动头尾指针(调用者需持有队列互斥锁)
+ * @param  queue_name: 输入参数, 队列名
+ * @param  pos       : 输入参数, 读取位置(头指针或头指针之后的位置)
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 获取长度
+ */
+static void queue_read_at(const queue_t *queue_name, const uint32_t pos, uint8_t *data, const uint32_t data_len)
+{
+    queue_segment_t seg1 = {0};
+    queue_segment_t seg2 = {0};
+    queue_get_segments(queue_name, pos, data_len, &seg1, &seg2);
+
+    memcpy(data, seg1.data, seg1.len);
+    if (seg2.len > 0)
+    {
+        memcpy(&data[seg1.len], seg2.data, seg2.len);
+    }
+}
+
+/**
+ * @brief  拷贝数据到队尾, 最多分两段拷贝(调用者需持有队列互斥锁, 并保证剩余空间足够)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ */
+static void queue_copy_in(queue_t *queue_name, const uint8_t *data, const uint32_t data_len)
+{
+    queue_write_at(queue_name, queue_name->tail, data, data_len);
+
+    queue_advance_tail(queue_name, data_len);
+}
+
+/**
+ * @brief  从队头拷贝数据, 最多分两段拷贝(调用者需持有队列互斥锁, 并保证队列数据足够)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 获取长度
+ */
+static void queue_copy_out(queue_t *queue_name, uint8_t *data, const uint32_t data_len)
+{
+    queue_read_at(queue_name, queue_name->head, data, data_len);
+
+    queue_advance_head(queue_name, data_len);
+}
+
+/**
+ * @brief  唤醒一个等待数据的消费者(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ */
+static inline void queue_wake_reader(queue_t *queue_name)
+{
+    // futex等待模式下修改唤醒序号, 解锁后再进入内核唤醒, 被唤醒的消费者不会立即阻塞在互斥锁上
+    // 已登记但还未进入futex等待的消费者会因序号改变而立即返回, 不会丢失唤醒
+    if (queue_name->flags & QUEUE_FLAG_FUTEX)
+    {
+        __atomic_store_n(&queue_name->futex_seq, (queue_name->futex_seq + 1), __ATOMIC_RELEASE);
+        queue_name->futex_wake = true;
+
+        return;
+    }
+
+    pthread_cond_signal(&queue_name->queue_cond);
+}
+
+/**
+ * @brief  解锁队列, 并执行延迟的futex唤醒
+ * @param  queue_name: 输出参数, 队列名
+ */
+static inline void queue_unlock(queue_t *queue_name)
+{
+    bool futex_wake = queue_name->futex_wake;
+    bool futex_wake_range = queue_name->futex_wake_range;
+    queue_set_t *wake_set = (queue_name->futex_wake_set ? queue_name->set : NULL);
+    queue_name->futex_wake = false;
+    queue_name->futex_wake_range = false;
+    queue_name->futex_wake_set = false;
+
+    pthread_mutex_unlock(&queue_name->queue_mutex);
+
+    if (futex_wake)
+    {
+        queue_sys_futex_wake(&queue_name->futex_seq, 1);
+    }
+
+    if (futex_wake_range)
+    {
+        queue_sys_futex_wake(&queue_name->range_seq, INT_MAX);
+    }
+
+    if (wake_set)
+    {
+        queue_sys_futex_wake(&wake_set->seq, INT_MAX);
+    }
+}
+
+/**
+ * @brief  有延迟的futex唤醒时, 解锁执行唤醒后重新加锁(调用者需持有队列互斥锁)
+ *         生产者等待空间前调用, 否则消费者和生产者可能互相等待
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 已解锁后重新加锁, 队列状态可能已改变, 调用者需重新检查
+ * @return false: 没有延迟的唤醒
+ */
+static inline bool queue_relock_for_wake(queue_t *queue_name)
+{
+    if ((!queue_name->futex_wake) && (!queue_name->futex_wake_range) && (!queue_name->futex_wake_set))
+    {
+        return false;
+    }
+
+    queue_unlock(queue_name);
+    queue_lock(queue_name);
+
+    return true;
+}
+
+/**
+ * @brief  递增所属队列集合的唤醒序号, 有等待的线程时解锁后唤醒(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ */
+static inline void queue_wake_set(queue_t *queue_name)
+{
+    queue_set_t *queue_set = queue_name->set;
+    if (!queue_set)
+    {
+        return;
+    }
+
+    __atomic_add_fetch(&queue_set->seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&queue_set->waiters, __ATOMIC_SEQ_CST) > 0)
+    {
+        queue_name->futex_wake_set = true;
+    }
+}
+
+/**
+ * @brief  唤醒全部等待最小长度的消费者(调用者需持有队列互斥锁)
+ *         唤醒后清除登记的最小长度, 数据仍不足的消费者再次等待时重新登记
+ * @param  queue_name: 输出参数, 队列名
+ */
+static inline void queue_wake_range_readers(queue_t *queue_name)
+{
+    queue_name->get_wait_need = 0;
+
+    if (queue_name->flags & QUEUE_FLAG_FUTEX)
+    {
+        __atomic_store_n(&queue_name->range_seq, (queue_name->range_seq + 1), __ATOMIC_RELEASE);
+        queue_name->futex_wake_range = true;
+
+        return;
+    }
+
+    pthread_cond_broadcast(&queue_name->range_cond);
+}
+
+/**
+ * @brief  按队列状态置位或清除事件fd(调用者需持有队列互斥锁)
+ *         只在状态改变时进入内核, 在锁内操作保证置位和清除的顺序与队列状态一致
+ * @param  queue_name: 输出参数, 队列名
+ */
+static void queue_update_events(queue_t *queue_name)
+{
+    if (queue_name->get_event_fd >= 0)
+    {
+        bool readable = (queue_get_used_size(queue_name) > 0);
+        if (readable != queue_name->get_event_set)
+        {
+            if (readable)
+            {
+                queue_sys_event_set(queue_name->get_event_fd);
+            }
+            else
+            {
+                queue_sys_event_clear(queue_name->get_event_fd);
+            }
+            queue_name->get_event_set = readable;
+        }
+    }
+
+    if (queue_name->put_event_fd >= 0)
+    {
+        uint32_t need =
+            ((queue_name->put_event_need > 0) ? queue_name->put_event_need : queue_get_unit_size(queue_name));
+        bool writable = ((0 == queue_name->put_reserved) && (queue_get_free_size(queue_name) >= need));
+        if (writable != queue_name->put_event_set)
+        {
+            if (writable)
+            {
+                queue_sys_event_set(queue_name->put_event_fd);
+            }
+            else
+            {
+                queue_sys_event_clear(queue_name->put_event_fd);
+            }
+            queue_name->put_event_set = writable;
+        }
+    }
+}
+
+/**
+ * @brief  关闭事件fd
+ * @param  queue_name: 输出参数, 队列名
+ */
+static void queue_close_events(queue_t *queue_name)
+{
+    if (queue_name->get_event_fd >= 0)
+    {
+        close(queue_name->get_event_fd);
+        queue_name->get_event_fd = -1;
+    }
+
+    if (queue_name->put_event_fd >= 0)
+    {
+        close(queue_name->put_event_fd);
+        queue_name->put_event_fd = -1;
+    }
+}
+
+/**
+ * @brief  整体写入空间不足时登记需要的空闲空间, 并清除可写事件fd(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  need      : 输入参数, 需要的空闲空间
+ */
+static inline void queue_put_event_need(queue_t *queue_name, const uint32_t need)
+{
+    if (queue_name->put_event_fd >= 0)
+    {
+        queue_name->put_event_need = need;
+        queue_update_events(queue_name);
+    }
+}
+
+/**
+ * @brief  按队列属性计算缓冲区的总大小
+ * @param  queue_size : 输入参数, 队列容量
+ * @param  attr       : 输入参数, 队列属性
+ * @param  buffer_size: 输出参数, 缓冲区的总大小
+ * @return true : 成功
+ * @return false: 失败(参数错误或容量超出范围)
+ */
+static bool queue_get_buffer_size(const uint32_t queue_size, const queue_attr_t *attr, uint32_t *buffer_size)
+{
+    if ((!queue_size) || (!attr) || (attr->wait_policy > QUEUE_WAIT_BUSY_POLL) ||
+        (attr->overflow_policy > QUEUE_OVERFLOW_OVERWRITE) ||
+        ((attr->element_size > 0) && (attr->flags & QUEUE_FLAG_MSG)))
+    {
+        return false;
+    }
+
+    // 固定大小元素队列的容量以元素个数计算
+    uint32_t unit_size = ((attr->element_size > 0) ? attr->element_size : 1);
+    uint64_t size = ((uint64_t)queue_size * unit_size);
+
+    uint32_t len = 0;
+    if (attr->flags & QUEUE_FLAG_POW2)
+    {
+        // 元素大小是2的幂时, 缓冲区才是元素大小的整数倍(镜像映射模式下元素跨越末尾也是连续的, 不受限制)
+        if ((size > (1U << 31)) || ((unit_size & (unit_size - 1)) && (!(attr->flags & QUEUE_FLAG_MIRROR))))
+        {
+            return false;
+        }
+
+        // 容量向上取整为2的幂, 头尾指针自由递增, 无需间隔元素
+        len = 1;
+        while (len < size)
+        {
+            len <<= 1;
+        }
+    }
+    else
+    {
+        if ((size + unit_size) > UINT32_MAX)
+        {
+            return false;
+        }
+
+        // 计算需要分配的内存空间
+        // 申请时, 需要多加一个间隔元素(固定大小元素队列的间隔为一个完整元素, 元素不会跨越缓冲区末尾)
+        len = (uint32_t)(size + unit_size);
+    }
+
+    // 镜像映射以页为单位, 缓冲区向上取整为页大小的整数倍(页大小为2的幂, 不影响2的幂模式)
+    if (attr->flags & QUEUE_FLAG_MIRROR)
+    {
+        uint32_t page_size = (uint32_t)sysconf(_SC_PAGESIZE);
+        if (len > (1U << 31))
+        {
+            return false;
+        }
+
+        len = (((len + page_size - 1) / page_size) * page_size);
+    }
+
+    *buffer_size = len;
+
+    return true;
+}
+
+/**
+ * @brief  释放缓冲区
+ * @param  queue_name: 输出参数, 队列名
+ */
+static void queue_free_buffer(queue_t *queue_name)
+{
+    // 进程间共享队列和持久化队列的缓冲区随映射解除释放
+    if (queue_name->flags & QUEUE_FLAG_MIRROR)
+    {
+        queue_sys_mirror_unmap(queue_name->data, queue_name->total_size);
+    }
+    else if (!(queue_name->flags & (QUEUE_FLAG_SHARED | QUEUE_FLAG_PERSIST)))
+    {
+        free(queue_name->data);
+    }
+    queue_name->data = NULL;
+}
+
+/**
+ * @brief  调整队列容量: 分配新缓冲区, 把已有数据按顺序拷贝到新缓冲区开头(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  queue_size: 输入参数, 新的队列容量(与初始化时单位相同)
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool queue_resize_locked(queue_t *queue_name, const uint32_t queue_size)
+{
+    queue_attr_t attr = {0};
+    attr.flags = queue_name->flags;
+    attr.element_size = queue_name->element_size;
+
+    uint32_t len = 0;
+    if (!queue_get_buffer_size(queue_size, &attr, &len))
+    {
+        return false;
+    }
+
+    // 预留空间和消费者视图中的地址指向旧缓冲区, 不能移动; 新容量还需满足正在等待的生产者和消费者
+    uint32_t used_size = queue_get_used_size(queue_name);
+    uint32_t capacity = ((queue_name->flags & QUEUE_FLAG_POW2) ? len : (len - 1));
+    if ((queue_name->put_reserved > 0) || (queue_name->get_viewed > 0) || (used_size > capacity) ||
+        (queue_name->put_wait_need > capacity) || (queue_name->get_wait_need > capacity))
+    {
+        return false;
+    }
+
+    uint8_t *data = NULL;
+    if (queue_name->flags & QUEUE_FLAG_MIRROR)
+    {
+        data = queue_sys_mirror_map(len);
+    }
+    else
+    {
+        data = (uint8_t *)malloc(len);
+    }
+    if (!data)
+    {
+        return false;
+    }
+
+    // 已有数据最多分两段, 拷贝后在新缓冲区中是连续的
+    queue_segment_t seg1 = {0};
+    queue_segment_t seg2 = {0};
+    queue_get_segments(queue_name, queue_name->head, used_size, &seg1, &seg2);
+    memcpy(data, seg1.data, seg1.len);
+    if (seg2.len > 0)
+    {
+        memcpy(&data[seg1.len], seg2.data, seg2.len);
+    }
+
+    queue_free_buffer(queue_name);
+    queue_name->data = data;
+    queue_name->total_size = len;
+    if (queue_name->flags & QUEUE_FLAG_POW2)
+    {
+        queue_name->mask = (len - 1);
+    }
+    queue_name->head = 0;
+    queue_name->tail = used_size;
+    queue_name->current_size = used_size;
+    queue_name->low_since_ns = 0;
+
+    // 扩容后空间可能已满足等待的生产者, 由各自重新检查
+    if ((queue_name->put_waiters > 0) && (queue_get_free_size(queue_name) >= queue_get_unit_size(queue_name)))
+    {
+        pthread_cond_broadcast(&queue_name->not_full_cond);
+    }
+
+    queue_update_events(queue_name);
+
+    return true;
+}
+
+/**
+ * @brief  空闲空间不足时按自动调整策略扩容(调用者需持有队列互斥锁)
+ *         容量成倍增加直到放得下需要的空间, 最多扩容到最大容量
+ * @param  queue_name: 输出参数, 队列名
+ * @param  need      : 输入参数, 需要的空闲空间
+ */
+static void queue_grow_locked(queue_t *queue_name, const uint32_t need)
+{
+    if ((0 == queue_name->max_size) || (queue_get_free_size(queue_name) >= need))
+    {
+        return;
+    }
+
+    uint32_t unit_size = queue_get_unit_size(queue_name);
+    uint64_t size = (queue_get_capacity(queue_name) / unit_size);
+    if (size >= queue_name->max_size)
+    {
+        return;
+    }
+
+    uint64_t want = (((uint64_t)queue_get_used_size(queue_name) + need + unit_size - 1) / unit_size);
+    while (size < want)
+    {
+        size = ((size > 0) ? (size * 2) : 1);
+    }
+    if (size > queue_name->max_size)
+    {
+        size = queue_name->max_size;
+    }
+
+    queue_resize_locked(queue_name, (uint32_t)size);
+}
+
+/**
+ * @brief  占用率持续低于1/4时按自动调整策略缩容(调用者需持有队列互斥锁)
+ *         每次容量减半, 不小于初始化时的容量
+ * @param  queue_name: 输出参数, 队列名
+ */
+static void queue_shrink_locked(queue_t *queue_name)
+{
+    uint32_t unit_size = queue_get_unit_size(queue_name);
+    uint32_t capacity = queue_get_capacity(queue_name);
+    uint32_t size = (capacity / unit_size);
+    if ((0 == queue_name->max_size) || (0 == queue_name->shrink_delay) || (size <= queue_name->min_size))
+    {
+        return;
+    }
+
+    if (((uint64_t)queue_get_used_size(queue_name) * 4) > capacity)
+    {
+        queue_name->low_since_ns = 0;
+
+        return;
+    }
+
+    // 只在占用率低时读取时间, 从开始变低算起
+    uint64_t now_ns = queue_sys_get_time_ns(CLOCK_MONOTONIC);
+    if (0 == queue_name->low_since_ns)
+    {
+        queue_name->low_since_ns = now_ns;
+
+        return;
+    }
+
+    if ((now_ns - queue_name->low_since_ns) < ((uint64_t)queue_name->shrink_delay * 1000000))
+    {
+        return;
+    }
+
+    size /= 2;
+    if (size < queue_name->min_size)
+    {
+        size = queue_name->min_size;
+    }
+
+    queue_resize_locked(queue_name, size);
+}
+
+/**
+ * @brief  数据写入后按需唤醒消费者(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  used_size : 输入参数, 写入前队列已用空间
+ * @param  put_num   : 输入参数, 写入个数
+ */
+static void queue_notify_put(queue_t *queue_name, const uint32_t used_size, const uint32_t put_num)
+{
+    // 只有存在等待的消费者, 且队列由空变为非空或数据量跨过唤醒阈值时才唤醒
+    // 被唤醒的消费者取完数据后, 如果还有剩余数据会继续唤醒下一个消费者
+    // 只统计存在等待的消费者但省略的唤醒, 没有等待者时本就不需要唤醒
+    uint32_t threshold = queue_name->signal_threshold;
+    if (queue_name->get_waiters > 0)
+    {
+        if ((0 == used_size) || ((threshold > 0) && (used_size < threshold) && ((used_size + put_num) >= threshold)))
+        {
+            queue_wake_reader(queue_name);
+        }
+        else
+        {
+            queue_name->skipped_signals++;
+        }
+    }
+
+    // 等待最小长度的消费者只在数据量跨过登记的最小长度时唤醒
+    uint32_t need = queue_name->get_wait_need;
+    if ((queue_name->range_waiters > 0) && (need > 0) && (used_size < need) && ((used_size + put_num) >= need))
+    {
+        queue_wake_range_readers(queue_name);
+    }
+
+    // 队列由空变为非空时唤醒所属队列集合
+    if (0 == used_size)
+    {
+        queue_wake_set(queue_name);
+    }
+
+    // 占用率超过1/4, 重新计算自动缩容的延迟
+    if ((queue_name->low_since_ns > 0) &&
+        ((((uint64_t)used_size + put_num) * 4) > queue_get_capacity(queue_name)))
+    {
+        queue_name->low_since_ns = 0;
+    }
+
+    // 写入成功后不再按上次失败的长度判断可写
+    queue_name->put_event_need = 0;
+    queue_update_events(queue_name);
+}
+
+/**
+ * @brief  写入数据到循环队列, 并按需唤醒消费者(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return 实际插入个数
+ */
+static uint32_t queue_write_locked(queue_t *queue_name, const uint8_t *data, const uint32_t data_len)
+{
+    // 有未提交的预留空间时, 其他写入需等待提交, 否则会写到预留空间之后
+    if (queue_name->put_reserved > 0)
+    {
+        return 0;
+    }
+
+    // 空间不足时先按自动调整策略扩容
+    queue_grow_locked(queue_name, data_len);
+
+    uint32_t used_size = queue_get_used_size(queue_name);
+
+    // 只计算一次剩余空间, 队列满时只插入能放下的部分
+    uint32_t put_num = (queue_get_capacity(queue_name) - used_size);
+    if (put_num > data_len)
+    {
+        put_num = data_len;
+    }
+
+    // 固定大小元素队列只写入完整的元素
+    if (queue_name->element_size > 1)
+    {
+        put_num -= (put_num % queue_name->element_size);
+    }
+
+    if (0 == put_num)
+    {
+        return 0;
+    }
+
+    queue_copy_in(queue_name, data, put_num);
+
+    queue_notify_put(queue_name, used_size, put_num);
+
+    return put_num;
+}
+
+/**
+ * @brief  整体写入数据到循环队列, 并按需唤醒消费者(调用者需持有队列互斥锁)
+ *         空闲空间检查和拷贝在同一次加锁中完成
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return true : 成功
+ * @return false: 空闲空间不足, 未写入任何数据
+ */
+static bool queue_write_all_locked(queue_t *queue_name, const uint8_t *data, const uint32_t data_len)
+{
+    queue_grow_locked(queue_name, data_len);
+
+    uint32_t used_size = queue_get_used_size(queue_name);
+    if ((queue_name->put_reserved > 0) || ((queue_get_capacity(queue_name) - used_size) < data_len))
+    {
+        queue_put_event_need(queue_name, data_len);
+
+        return false;
+    }
+
+    queue_copy_in(queue_name, data, data_len);
+
+    queue_notify_put(queue_name, used_size, data_len);
+
+    return true;
+}
+
+/**
+ * @brief  按溢出策略写入数据到循环队列(不等待, 调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return 实际插入个数(覆盖最旧数据策略下包含因超过队列容量而跳过的部分)
+ */
+static uint32_t queue_write_policy_locked(queue_t *queue_name, const uint8_t *data, const uint32_t data_len)
+{
+    uint32_t put_num = 0;
+
+    // 能够扩容时不丢弃数据, 达到最大容量后才按溢出策略处理
+    queue_grow_locked(queue_name, data_len);
+
+    if (QUEUE_OVERFLOW_REJECT == queue_name->overflow_policy)
+    {
+        put_num = (queue_write_all_locked(queue_name, data, data_len) ? data_len : 0);
+    }
+    else if ((QUEUE_OVERFLOW_OVERWRITE == queue_name->overflow_policy) && (0 == queue_name->put_reserved) &&
+             (0 == queue_name->get_viewed))
+    {
+        // 新数据超过队列容量时只保留最后的部分(固定大小元素队列按完整元素计算)
+        uint32_t unit_size = queue_get_unit_size(queue_name);
+        uint32_t capacity = queue_get_capacity(queue_name);
+        capacity -= (capacity % unit_size);
+        uint32_t skip_len = ((data_len > capacity) ? (data_len - capacity) : 0);
+        skip_len += ((unit_size - (skip_len % unit_size)) % unit_size);
+
+        // 丢弃队头最旧的数据, 腾出新数据需要的空间(有预留或消费者视图时不能丢弃, 退化为只写入能放下的部分)
+        uint32_t put_len = (data_len - skip_len);
+        uint32_t free_size = queue_get_free_size(queue_name);
+        if (free_size < put_len)
+        {
+            uint32_t drop_len = (put_len - free_size);
+            drop_len += ((unit_size - (drop_len % unit_size)) % unit_size);
+            queue_advance_head(queue_name, drop_len);
+            queue_name->dropped_bytes += drop_len;
+        }
+
+        put_num = (skip_len + queue_write_locked(queue_name, &data[skip_len], put_len));
+        queue_name->dropped_bytes += skip_len;
+    }
+    else
+    {
+        put_num = queue_write_locked(queue_name, data, data_len);
+    }
+
+    queue_name->dropped_bytes += (data_len - put_num);
+
+    return put_num;
+}
+
+/**
+ * @brief  获取消费者可读取的长度(调用者需持有队列互斥锁)
+ * @param  queue_name: 输入参数, 队列名
+ * @return 可读取的长度
+ */
+static inline uint32_t queue_get_readable_size(const queue_t *queue_name)
+{
+    // 有未释放的消费者视图时, 其他读取需等待释放, 否则视图中的数据会被重复读取
+    if (queue_name->get_viewed > 0)
+    {
+        return 0;
+    }
+
+    return queue_get_used_size(queue_name);
+}
+
+/**
+ * @brief  数据读取后按需唤醒生产者和其他消费者(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  used_size : 输入参数, 读取前队列已用空间
+ * @param  get_num   : 输入参数, 读取个数
+ */
+static void queue_notify_get(queue_t *queue_name, const uint32_t used_size, const uint32_t get_num)
+{
+    // 只有存在等待的生产者, 且读取前空闲空间不能满足等待的生产者时才唤醒
+    // 等待的生产者都只需一个最小单位时, 即队列由满变为未满; 有生产者等待整条消息时, 唤醒全部生产者各自检查空间
+    // 只统计存在等待的生产者但省略的唤醒, 没有等待者或没有读取数据时本就不需要唤醒
+    uint32_t unit_size = queue_get_unit_size(queue_name);
+    uint32_t need = ((queue_name->put_wait_need > 0) ? queue_name->put_wait_need : unit_size);
+    if ((queue_name->put_waiters > 0) && (get_num > 0))
+    {
+        if ((queue_get_capacity(queue_name) - used_size) < need)
+        {
+            if (need > unit_size)
+            {
+                pthread_cond_broadcast(&queue_name->not_full_cond);
+            }
+            else
+            {
+                pthread_cond_signal(&queue_name->not_full_cond);
+            }
+        }
+        else
+        {
+            queue_name->skipped_signals++;
+        }
+    }
+
+    // 还有剩余数据, 继续唤醒下一个等待的消费者
+    if ((queue_name->get_waiters > 0) && (get_num < used_size))
+    {
+        queue_wake_reader(queue_name);
+    }
+
+    // 消费者视图释放后, 剩余数据可能已满足等待最小长度的消费者
+    uint32_t get_need = queue_name->get_wait_need;
+    if ((queue_name->range_waiters > 0) && (get_need > 0) && ((used_size - get_num) >= get_need))
+    {
+        queue_wake_range_readers(queue_name);
+    }
+
+    queue_shrink_locked(queue_name);
+
+    queue_update_events(queue_name);
+}
+
+/**
+ * @brief  从循环队列中获取数据, 并按需唤醒生产者(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @return 实际获取个数
+ */
+static uint32_t queue_read_locked(queue_t *queue_name, uint8_t *data, const uint32_t data_len)
+{
+    // 只计算一次可读长度
+    uint32_t used_size = queue_get_readable_size(queue_name);
+    uint32_t get_num = ((used_size < data_len) ? used_size : data_len);
+
+    // 固定大小元素队列只读取完整的元素
+    if (queue_name->element_size > 1)
+    {
+        get_num -= (get_num % queue_name->element_size);
+    }
+
+    if (0 == get_num)
+    {
+        return 0;
+    }
+
+    queue_copy_out(queue_name, data, get_num);
+
+    queue_notify_get(queue_name, used_size, get_num);
+
+    return get_num;
+}
+
+/**
+ * @brief  计算消息长度头的字节数
+ * @param  queue_name: 输入参数, 队列名
+ * @param  msg_len   : 输入参数, 消息长度
+ * @return 长度头的字节数(1~5, 持久化队列另加校验和长度)
+ */
+static inline uint32_t queue_msg_header_len(const queue_t *queue_name, uint32_t msg_len)
+{
+    uint32_t header_len = 1;
+    while (msg_len >= 0x80)
+    {
+        msg_len >>= 7;
+        header_len++;
+    }
+
+    if (queue_name->flags & QUEUE_FLAG_PERSIST)
+    {
+        header_len += QUEUE_CHECKSUM_LEN;
+    }
+
+    return header_len;
+}
+
+/**
+ * @brief  计算校验和(FNV-1a), 可分段累加
+ * @param  hash: 输入参数, 上一段的校验和(第一段为QUEUE_CHECKSUM_INIT)
+ * @param  data: 输入参数, 数据
+ * @param  len : 输入参数, 数据长度
+ * @return 校验和
+ */
+static uint32_t queue_checksum(uint32_t hash, const uint8_t *data, const uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        hash ^= data[i];
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief  写入一条完整消息, 并按需唤醒消费者(调用者需持有队列互斥锁)
+ *         长度头使用变长编码(每字节低7位为数据, 最高位表示后面还有字节), 小消息只需1字节
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 消息内容
+ * @param  data_len  : 输入参数, 消息长度
+ * @return true : 成功
+ * @return false: 空闲空间不足
+ */
+static bool queue_write_msg_locked(queue_t *queue_name, const uint8_t *data, const uint32_t data_len)
+{
+    uint8_t header[5 + QUEUE_CHECKSUM_LEN] = {0};
+    uint32_t header_len = 0;
+    uint32_t msg_len = data_len;
+    while (msg_len >= 0x80)
+    {
+        header[header_len++] = (uint8_t)(msg_len | 0x80);
+        msg_len >>= 7;
+    }
+    header[header_len++] = (uint8_t)msg_len;
+
+    // 持久化队列在长度头之后写入消息内容的校验和, 恢复后读取时校验
+    if (queue_name->flags & QUEUE_FLAG_PERSIST)
+    {
+        uint32_t checksum = queue_checksum(QUEUE_CHECKSUM_INIT, data, data_len);
+        memcpy(&header[header_len], &checksum, QUEUE_CHECKSUM_LEN);
+        header_len += QUEUE_CHECKSUM_LEN;
+    }
+
+    queue_grow_locked(queue_name, (header_len + data_len));
+
+    uint32_t used_size = queue_get_used_size(queue_name);
+    if ((queue_name->put_reserved > 0) || (queue_get_free_size(queue_name) < (header_len + data_len)))
+    {
+        queue_put_event_need(queue_name, (header_len + data_len));
+
+        return false;
+    }
+
+    // 长度头和消息都写入后才一次移动尾指针, 消费者和恢复后的持久化队列只能看到完整的消息
+    queue_write_at(queue_name, queue_name->tail, header, header_len);
+    queue_write_at(queue_name, queue_advance(queue_name, queue_name->tail, header_len), data, data_len);
+    queue_advance_tail(queue_name, (header_len + data_len));
+
+    queue_notify_put(queue_name, used_size, (header_len + data_len));
+
+    return true;
+}
+
+/**
+ * @brief  解析队头消息的长度头(调用者需持有队列互斥锁)
+ * @param  queue_name: 输入参数, 队列名
+ * @param  header_len: 输出参数, 长度头的字节数
+ * @return 队头消息的长度(队列为空时为0)
+ */
+static uint32_t queue_peek_msg_locked(const queue_t *queue_name, uint32_t *header_len)
+{
+    uint32_t used_size = queue_get_readable_size(queue_name);
+    if (0 == used_size)
+    {
+        *header_len = 0;
+
+        return 0;
+    }
+
+    // 长度头最多5字节, 可能跨越缓冲区末尾
+    queue_segment_t seg1 = {0};
+    queue_segment_t seg2 = {0};
+    queue_get_segments(queue_name, queue_name->head, ((used_size < 5) ? used_size : 5), &seg1, &seg2);
+
+    uint32_t msg_len = 0;
+    uint32_t i = 0;
+    for (i = 0; i < (seg1.len + seg2.len); i++)
+    {
+        uint8_t c = ((i < seg1.len) ? seg1.data[i] : seg2.data[i - seg1.len]);
+        msg_len |= ((uint32_t)(c & 0x7F) << (7 * i));
+        if (!(c & 0x80))
+        {
+            break;
+        }
+    }
+    *header_len = (i + 1);
+    if (queue_name->flags & QUEUE_FLAG_PERSIST)
+    {
+        *header_len += QUEUE_CHECKSUM_LEN;
+    }
+
+    return msg_len;
+}
+
+/**
+ * @brief  校验持久化队列的队头消息(调用者需持有队列互斥锁)
+ * @param  queue_name: 输入参数, 队列名
+ * @param  header_len: 输入参数, 长度头的字节数(包含校验和)
+ * @param  msg_len   : 输入参数, 消息长度
+ * @return true : 校验通过
+ * @return false: 消息不完整或校验和不匹配
+ */
+static bool queue_check_msg_locked(const queue_t *queue_name, const uint32_t header_len, const uint32_t msg_len)
+{
+    if (((uint64_t)header_len + msg_len) > queue_get_readable_size(queue_name))
+    {
+        return false;
+    }
+
+    queue_segment_t seg1 = {0};
+    queue_segment_t seg2 = {0};
+
+    // 校验和在长度头的最后, 可能跨越缓冲区末尾
+    uint32_t checksum = 0;
+    uint8_t *dest = (uint8_t *)&checksum;
+    uint32_t pos = queue_advance(queue_name, queue_name->head, (header_len - QUEUE_CHECKSUM_LEN));
+    queue_get_segments(queue_name, pos, QUEUE_CHECKSUM_LEN, &seg1, &seg2);
+    memcpy(dest, seg1.data, seg1.len);
+    memcpy(&dest[seg1.len], seg2.data, seg2.len);
+
+    pos = queue_advance(queue_name, queue_name->head, header_len);
+    queue_get_segments(queue_name, pos, msg_len, &seg1, &seg2);
+    uint32_t hash = queue_checksum(QUEUE_CHECKSUM_INIT, seg1.data, seg1.len);
+    hash = queue_checksum(hash, seg2.data, seg2.len);
+
+    return (hash == checksum);
+}
+
+/**
+ * @brief  解析并校验队头消息的长度头(调用者需持有队列互斥锁, 丢弃数据后需调用queue_notify_get())
+ *         持久化队列校验失败时丢弃全部数据, 并计入丢弃字节数
+ * @param  queue_name: 输出参数, 队列名
+ * @param  header_len: 输出参数, 长度头的字节数(队列为空或数据被丢弃时为0)
+ * @return 队头消息的长度(队列为空或数据被丢弃时为0)
+ */
+static uint32_t queue_verify_msg_locked(queue_t *queue_name, uint32_t *header_len)
+{
+    uint32_t msg_len = queue_peek_msg_locked(queue_name, header_len);
+    if ((0 == *header_len) || (!(queue_name->flags & QUEUE_FLAG_PERSIST)))
+    {
+        return msg_len;
+    }
+
+    // 系统掉电时尾指针可能先于消息内容写入文件, 校验失败说明之后的数据都不可信, 全部丢弃
+    if (!queue_check_msg_locked(queue_name, *header_len, msg_len))
+    {
+        uint32_t drop_len = queue_get_readable_size(queue_name);
+        queue_advance_head(queue_name, drop_len);
+        queue_name->dropped_bytes += drop_len;
+        *header_len = 0;
+
+        return 0;
+    }
+
+    return msg_len;
+}
+
+/**
+ * @brief  获取一条完整消息(调用者需持有队列互斥锁, 并在读取完成后调用queue_notify_get())
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的消息
+ * @param  data_len  : 输入参数, 消息缓冲区大小
+ * @return 成功: 消息长度(队列为空时为0)
+ *         失败: -1(缓冲区不足, 消息保留在队列中)
+ */
+static int queue_read_msg_locked(queue_t *queue_name, uint8_t *data, const uint32_t data_len)
+{
+    uint32_t header_len = 0;
+    uint32_t msg_len = queue_verify_msg_locked(queue_name, &header_len);
+    if (0 == header_len)
+    {
+        return 0;
+    }
+
+    if (msg_len > data_len)
+    {
+        return -1;
+    }
+
+    // 消息拷贝完成后才一次移动头指针
+    queue_read_at(queue_name, queue_advance(queue_name, queue_name->head, header_len), data, msg_len);
+    queue_advance_head(queue_name, (header_len + msg_len));
+
+    return msg_len;
+}
+
+/**
+ * @brief  覆盖最旧数据策略下丢弃队头的完整消息, 直到空闲空间足够(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  need      : 输入参数, 需要的空闲空间(不能超过队列容量)
+ */
+static void queue_drop_msgs_locked(queue_t *queue_name, const uint32_t need)
+{
+    // 能够扩容时不丢弃消息
+    queue_grow_locked(queue_name, need);
+
+    while (queue_get_free_size(queue_name) < need)
+    {
+        uint32_t header_len = 0;
+        uint32_t msg_len = queue_peek_msg_locked(queue_name, &header_len);
+        uint32_t used_size = queue_get_used_size(queue_name);
+
+        // 长度头损坏时(只可能出现在恢复后的持久化队列中)丢弃全部数据
+        uint64_t drop_len = ((uint64_t)header_len + msg_len);
+        if ((0 == header_len) || (drop_len > used_size))
+        {
+            drop_len = used_size;
+        }
+
+        queue_advance_head(queue_name, (uint32_t)drop_len);
+        queue_name->dropped_bytes += drop_len;
+    }
+}
+
+/**
+ * @brief  写入数据到循环队列, 队列满时等待消费者释放空间
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @param  end_time  : 输入参数, 超时结束时间(为NULL时一直等待)
+ * @return 成功: 实际插入个数
+ *         失败: -1(超时且未写入任何数据)
+ */
+static int queue_write_wait(queue_t *queue_name, const uint8_t *data, const uint32_t data_len,
+                            const struct timespec *end_time)
+{
+    // 实际插入个数
+    uint32_t put_num = 0;
+
+    queue_lock(queue_name);
+
+    while (true)
+    {
+        put_num += queue_write_locked(queue_name, &data[put_num], (data_len - put_num));
+        if (put_num == data_len)
+        {
+            break;
+        }
+
+        // 队列已满, 等待前先在解锁后唤醒消费者, 重新加锁后空间可能已释放, 需再次写入
+        if (queue_relock_for_wake(queue_name))
+        {
+            continue;
+        }
+
+        // 等待消费者释放空间
+        int ret = 0;
+        queue_name->put_waiters++;
+        ret = queue_cond_wait(queue_name, &queue_name->not_full_cond, end_time);
+        queue_name->put_waiters--;
+        if (0 == queue_name->put_waiters)
+        {
+            queue_name->put_wait_need = 0;
+        }
+
+        // 超时, 写入能放下的部分后返回
+        if (ETIMEDOUT == ret)
+        {
+            put_num += queue_write_locked(queue_name, &data[put_num], (data_len - put_num));
+
+            break;
+        }
+    }
+
+    // 还有剩余空间, 继续唤醒下一个等待的生产者
+    if ((queue_name->put_waiters > 0) && (queue_get_free_size(queue_name) >= queue_get_unit_size(queue_name)))
+    {
+        pthread_cond_signal(&queue_name->not_full_cond);
+    }
+
+    queue_unlock(queue_name);
+
+    return ((put_num > 0) ? (int)put_num : -1);
+}
+
+/**
+ * @brief  等待队列空闲空间满足指定长度(调用者需持有队列互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  need      : 输入参数, 需要的空闲空间
+ * @param  end_time  : 输入参数, 超时结束时间(为NULL时一直等待)
+ * @return true : 空闲空间足够
+ * @return false: 超时
+ */
+static bool queue_wait_writable(queue_t *queue_name, const uint32_t need, const struct timespec *end_time)
+{
+    queue_grow_locked(queue_name, need);
+
+    while ((queue_name->put_reserved > 0) || (queue_get_free_size(queue_name) < need))
+    {
+        // 等待前先在解锁后唤醒消费者, 重新加锁后空间可能已释放, 需再次检查
+        if (queue_relock_for_wake(queue_name))
+        {
+            continue;
+        }
+
+        // 登记需要的空间, 消费者释放空间后据此决定是否唤醒
+        int ret = 0;
+        queue_name->put_waiters++;
+        if (need > queue_name->put_wait_need)
+        {
+            queue_name->put_wait_need = need;
+        }
+        ret = queue_cond_wait(queue_name, &queue_name->not_full_cond, end_time);
+        queue_name->put_waiters--;
+        if (0 == queue_name->put_waiters)
+        {
+            queue_name->put_wait_need = 0;
+        }
+
+        // 超时, 直接返回
+        if ((ETIMEDOUT == ret) && ((queue_name->put_reserved > 0) || (queue_get_free_size(queue_name) < need)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  整体写入数据到循环队列, 空闲空间不足时等待
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @param  end_time  : 输入参数, 超时结束时间(为NULL时一直等待)
+ * @return 成功: 插入个数(等于待插入数据长度)
+ *         失败: -1(数据长度超过队列容量或超时)
+ */
+static int queue_write_all_wait(queue_t *queue_name, const uint8_t *data, const uint32_t data_len,
+                                const struct timespec *end_time)
+{
+    queue_lock(queue_name);
+
+    // 数据超过队列容量, 永远无法整体写入
+    if (data_len > queue_get_max_capacity(queue_name))
+    {
+        pthread_mutex_unlock(&queue_name->queue_mutex);
+
+        return -1;
+    }
+
+    // 等待期间登记需要的长度, 消费者释放足够的空间后才唤醒
+    if ((!queue_wait_writable(queue_name, data_len, end_time)) ||
+        (!queue_write_all_locked(queue_name, data, data_len)))
+    {
+        queue_unlock(queue_name);
+
+        return -1;
+    }
+
+    queue_unlock(queue_name);
+
+    return data_len;
+}
+
+/**
+ * @brief  按等待策略自旋等待数据(调用者需持有队列互斥锁, 自旋期间释放互斥锁)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  need      : 输入参数, 需要的数据长度
+ * @param  end_time  : 输入参数, 超时结束时间(为NULL时一直等待)
+ */
+static void queue_spin_wait(queue_t *queue_name, const uint32_t need, const struct timespec *end_time)
+{
+    // 自旋结束时间(单位: ns), 0表示不按时间限制
+    uint64_t spin_end_ns = 0;
+
+    switch (queue_name->wait_policy)
+    {
+    case QUEUE_WAIT_SPIN_THEN_BLOCK:
+    {
+        break;
+    }
+
+    case QUEUE_WAIT_ADAPTIVE:
+    {
+        // 预计等待时间超过最大自旋时间时, 自旋大概率白白消耗CPU, 直接休眠
+        if (queue_name->wait_stats.avg_wait_ns > queue_name->max_spin_ns)
+        {
+            return;
+        }
+
+        // 自旋时间为平均等待时间的2倍, 不超过最大自旋时间
+        uint64_t spin_ns = ((uint64_t)queue_name->wait_stats.avg_wait_ns * 2);
+        if ((0 == spin_ns) || (spin_ns > queue_name->max_spin_ns))
+        {
+            spin_ns = queue_name->max_spin_ns;
+        }
+
+        spin_end_ns = (queue_sys_get_time_ns(CLOCK_MONOTONIC) + spin_ns);
+
+        break;
+    }
+
+    case QUEUE_WAIT_BUSY_POLL:
+    {
+        if (end_time)
+        {
+            spin_end_ns = queue_sys_timespec_to_ns(end_time);
+        }
+
+        break;
+    }
+
+    default:
+    {
+        return;
+    }
+    }
+
+    pthread_mutex_unlock(&queue_name->queue_mutex);
+
+    bool hit = false;
+    for (uint32_t i = 0;; i++)
+    {
+        if (queue_peek_readable_size(queue_name) >= need)
+        {
+            hit = true;
+
+            break;
+        }
+
+        if ((QUEUE_WAIT_SPIN_THEN_BLOCK == queue_name->wait_policy) && (i >= queue_name->spin_count))
+        {
+            break;
+        }
+
+        // 每自旋64次检查一次时间, 减少读取时钟的开销
+        if ((spin_end_ns > 0) && (63 == (i & 63)) && (queue_sys_get_time_ns(CLOCK_MONOTONIC) >= spin_end_ns))
+        {
+            break;
+        }
+
+        queue_sys_cpu_relax();
+    }
+
+    queue_lock(queue_name);
+
+    if (hit)
+    {
+        queue_name->wait_stats.spin_hits++;
+    }
+    else
+    {
+        queue_name->wait_stats.spin_misses++;
+    }
+}
+
+/**
+ * @brief  等待队列中可读取的数据达到指定长度(调用者需持有队列互斥锁)
+ *         只需1字节的消费者在队列非空时被唤醒, 需要更多数据的消费者在数据量跨过登记的最小长度时被唤醒
+ * @param  queue_name: 输出参数, 队列名
+ * @param  need      : 输入参数, 需要的数据长度(不能超过队列容量)
+ * @param  end_time  : 输入参数, 超时结束时间(为NULL时一直等待)
+ * @return true : 可读取的数据达到指定长度
+ * @return false: 超时
+ */
+static bool queue_wait_readable(queue_t *queue_name, const uint32_t need, const struct timespec *end_time)
+{
+    // 开始等待的时间(自适应策略统计等待时间使用)
+    uint64_t start_ns = 0;
+
+    if ((queue_get_readable_size(queue_name) < need) && (QUEUE_WAIT_BLOCK != queue_name->wait_policy))
+    {
+        if (QUEUE_WAIT_ADAPTIVE == queue_name->wait_policy)
+        {
+            start_ns = queue_sys_get_time_ns(CLOCK_MONOTONIC);
+        }
+
+        queue_spin_wait(queue_name, need, end_time);
+    }
+
+    // 数据不足才等待信号, 等待和拷贝在同一次加锁中完成
+    // 使用while而不使用if, 防止该线程进入睡眠时, 被其他信号打断, 而过早的退出睡眠
+    bool range = (need > 1);
+    uint32_t *futex_seq = (range ? &queue_name->range_seq : &queue_name->futex_seq);
+    pthread_cond_t *cond = (range ? &queue_name->range_cond : &queue_name->queue_cond);
+    while (queue_get_readable_size(queue_name) < need)
+    {
+        int ret = 0;
+        queue_name->wait_stats.blocks++;
+        if (range)
+        {
+            queue_name->range_waiters++;
+            if ((0 == queue_name->get_wait_need) || (need < queue_name->get_wait_need))
+            {
+                queue_name->get_wait_need = need;
+            }
+        }
+        else
+        {
+            queue_name->get_waiters++;
+        }
+        if (queue_name->flags & QUEUE_FLAG_FUTEX)
+        {
+            // futex等待模式下解锁后直接在唤醒序号上等待, 唤醒后只需加锁一次即可拷贝
+            uint32_t seq = *futex_seq;
+
+            pthread_mutex_unlock(&queue_name->queue_mutex);
+
+            ret = queue_sys_futex_wait(futex_seq, seq, end_time);
+
+            queue_lock(queue_name);
+        }
+        else
+        {
+            ret = queue_cond_wait(queue_name, cond, end_time);
+        }
+        if (range)
+        {
+            queue_name->range_waiters--;
+        }
+        else
+        {
+            queue_name->get_waiters--;
+        }
+
+        // 超时, 直接返回
+        if ((ETIMEDOUT == ret) && (queue_get_readable_size(queue_name) < need))
+        {
+            return false;
+        }
+    }
+
+    // 更新平均等待时间, 新样本权重为1/8
+    if (start_ns > 0)
+    {
+        int64_t wait_ns = (int64_t)(queue_sys_get_time_ns(CLOCK_MONOTONIC) - start_ns);
+        int64_t avg_wait_ns = queue_name->wait_stats.avg_wait_ns;
+        avg_wait_ns += ((wait_ns - avg_wait_ns) / 8);
+        queue_name->wait_stats.avg_wait_ns = ((avg_wait_ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)avg_wait_ns);
+    }
+
+    return true;
+}
+
+/**
+ * @brief  从循环队列中获取数据, 队列为空时等待生产者写入
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @param  end_time  : 输入参数, 超时结束时间(为NULL时一直等待)
+ * @return 成功: 实际获取个数
+ *         失败: -1
+ */
+static int queue_read_wait(queue_t *queue_name, uint8_t *data, const uint32_t data_len,
+                           const struct timespec *end_time)
+{
+    queue_lock(queue_name);
+
+    if (!queue_wait_readable(queue_name, 1, end_time))
+    {
+        queue_unlock(queue_name);
+
+        return -1;
+    }
+
+    uint32_t get_num = queue_read_locked(queue_name, data, data_len);
+
+    queue_unlock(queue_name);
+
+    return get_num;
+}
+
+/**
+ * @brief  按长度范围从循环队列中获取数据
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  min_len   : 输入参数, 最小获取长度
+ * @param  max_len   : 输入参数, 最大获取长度
+ * @param  wait      : 输入参数, 数据不足最小长度时是否等待
+ * @param  end_time  : 输入参数, 超时结束时间(为NULL时一直等待)
+ * @return 成功: 实际获取个数(不等待且数据不足最小长度时为0)
+ *         失败: -1(参数错误或超时)
+ */
+static int queue_read_range(queue_t *queue_name, uint8_t *data, const uint32_t min_len, const uint32_t max_len,
+                            const bool wait, const struct timespec *end_time)
+{
+    // 实际获取个数
+    uint32_t get_num = 0;
+
+    if ((!queue_name) || (!data) || (!min_len) || (min_len > max_len) || (!queue_is_byte_stream(queue_name)) ||
+        (min_len > queue_get_max_capacity(queue_name)))
+    {
+        return -1;
+    }
+
+    queue_lock(queue_name);
+
+    if ((wait) && (!queue_wait_readable(queue_name, min_len, end_time)))
+    {
+        queue_unlock(queue_name);
+
+        return -1;
+    }
+
+    if (queue_get_readable_size(queue_name) >= min_len)
+    {
+        get_num = queue_read_locked(queue_name, data, max_len);
+    }
+
+    queue_unlock(queue_name);
+
+    return get_num;
+}
+
+/**
+ * @brief  检查队列集合中非空的队列(不加锁读取各个队列的已用空间, 获取数据时需再次确认)
+ * @param  queue_set: 输出参数, 队列集合
+ * @param  ready    : 输出参数, 非空的队列
+ * @param  ready_num: 输入参数, ready数组大小
+ * @return 非空的队列个数
+ */
+static uint32_t queue_set_get_ready(queue_set_t *queue_set, queue_t **ready, const uint32_t ready_num)
+{
+    uint32_t queue_num = queue_set->queue_num;
+    if (0 == queue_num)
+    {
+        return 0;
+    }
+
+    // 每次从不同的队列开始检查, ready数组放不下全部非空队列时, 各个队列轮流优先
+    uint32_t start_index = (__atomic_fetch_add(&queue_set->start_index, 1, __ATOMIC_RELAXED) % queue_num);
+    uint32_t ready_count = 0;
+    for (uint32_t i = 0; ((i < queue_num) && (ready_count < ready_num)); i++)
+    {
+        queue_t *queue_name = queue_set->queues[((start_index + i) % queue_num)];
+        if (queue_peek_readable_size(queue_name) > 0)
+        {
+            ready[ready_count++] = queue_name;
+        }
+    }
+
+    return ready_count;
+}
+
+/**
+ * @brief  等待队列集合中任意一个队列非空
+ * @param  queue_set: 输出参数, 队列集合
+ * @param  ready    : 输出参数, 非空的队列
+ * @param  ready_num: 输入参数, ready数组大小
+ * @param  end_time : 输入参数, 超时结束时间(为NULL时一直等待)
+ * @return 成功: 非空的队列个数
+ *         失败: -1(超时)
+ */
+static int queue_set_wait_ready(queue_set_t *queue_set, queue_t **ready, const uint32_t ready_num,
+                                const struct timespec *end_time)
+{
+    while (true)
+    {
+        // 先登记等待并读取唤醒序号再检查队列, 与生产者"先写入数据再递增唤醒序号"配对, 避免丢失唤醒
+        __atomic_add_fetch(&queue_set->waiters, 1, __ATOMIC_SEQ_CST);
+        uint32_t seq = __atomic_load_n(&queue_set->seq, __ATOMIC_SEQ_CST);
+
+        uint32_t ready_count = queue_set_get_ready(queue_set, ready, ready_num);
+        if (ready_count > 0)
+        {
+            __atomic_sub_fetch(&queue_set->waiters, 1, __ATOMIC_RELAXED);
+
+            return ready_count;
+        }
+
+        int ret = queue_sys_futex_wait(&queue_set->seq, seq, end_time);
+
+        __atomic_sub_fetch(&queue_set->waiters, 1, __ATOMIC_RELAXED);
+
+        // 超时, 最后再检查一次
+        if (ETIMEDOUT == ret)
+        {
+            ready_count = queue_set_get_ready(queue_set, ready, ready_num);
+
+            return ((ready_count > 0) ? (int)ready_count : -1);
+        }
+    }
+}
+
+/**
+ * @brief  按同步策略将持久化队列同步到文件(读写完成并解锁后调用)
+ * @param  queue_name: 输入参数, 队列名
+ */
+static void queue_persist_sync(queue_t *queue_name)
+{
+    if (!(queue_name->flags & QUEUE_FLAG_PERSIST))
+    {
+        return;
+    }
+
+    queue_shared_t *shared = (queue_shared_t *)queue_name;
+    if (QUEUE_SYNC_COMMIT == shared->sync_policy)
+    {
+        msync(shared, shared->map_size, MS_SYNC);
+    }
+    else if (QUEUE_SYNC_PERIODIC == shared->sync_policy)
+    {
+        // 距上次同步超过同步间隔时, 只由一个线程执行同步
+        uint64_t now_ns = queue_sys_get_time_ns(CLOCK_MONOTONIC);
+        uint64_t last_ns = __atomic_load_n(&shared->last_sync_ns, __ATOMIC_RELAXED);
+        if (((now_ns - last_ns) >= ((uint64_t)shared->sync_interval * 1000000)) &&
+            (__atomic_compare_exchange_n(&shared->last_sync_ns, &last_ns, now_ns, false, __ATOMIC_RELAXED,
+                                         __ATOMIC_RELAXED)))
+        {
+            msync(shared, shared->map_size, MS_SYNC);
+        }
+    }
+}
+
+/**
+ * @brief  初始化队列的运行时状态: 等待者、预留和视图、事件fd、互斥锁和条件变量
+ *         不修改头尾指针和缓冲区信息, 持久化队列恢复时直接在映射的文件上调用
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败(创建事件fd失败)
+ */
+static bool queue_init_runtime(queue_t *queue_name)
+{
+    queue_name->get_waiters = 0;
+    queue_name->put_waiters = 0;
+    queue_name->put_wait_need = 0;
+    queue_name->futex_wake = false;
+    queue_name->range_waiters = 0;
+    queue_name->get_wait_need = 0;
+    queue_name->futex_wake_range = false;
+    queue_name->put_reserved = 0;
+    queue_name->get_viewed = 0;
+    queue_name->get_event_fd = -1;
+    queue_name->put_event_fd = -1;
+    queue_name->get_event_set = false;
+    queue_name->put_event_set = false;
+    queue_name->set = NULL;
+    queue_name->futex_wake_set = false;
+    queue_name->put_event_need = 0;
+    queue_name->low_since_ns = 0;
+
+    // 创建事件fd, 按队列当前状态置位
+    if (queue_name->flags & QUEUE_FLAG_GET_FD)
+    {
+        queue_name->get_event_fd = queue_sys_event_create();
+    }
+    if (queue_name->flags & QUEUE_FLAG_PUT_FD)
+    {
+        queue_name->put_event_fd = queue_sys_event_create();
+    }
+    if (((queue_name->flags & QUEUE_FLAG_GET_FD) && (queue_name->get_event_fd < 0)) ||
+        ((queue_name->flags & QUEUE_FLAG_PUT_FD) && (queue_name->put_event_fd < 0)))
+    {
+        queue_close_events(queue_name);
+
+        return false;
+    }
+    queue_update_events(queue_name);
+
+    // 单核系统上自旋只会占用生产者的运行时间, 自旋策略退化为直接休眠
+    if ((1 == sysconf(_SC_NPROCESSORS_ONLN)) && ((QUEUE_WAIT_SPIN_THEN_BLOCK == queue_name->wait_policy) ||
+                                                  (QUEUE_WAIT_ADAPTIVE == queue_name->wait_policy)))
+    {
+        queue_name->wait_policy = QUEUE_WAIT_BLOCK;
+    }
+
+    // 初始化互斥锁, 进程间共享队列使用健壮锁, 避免持有锁的进程退出后其他进程永久阻塞
+    pthread_mutexattr_t mutex_attr;
+    pthread_mutexattr_init(&mutex_attr);
+    if (queue_name->flags & QUEUE_FLAG_SHARED)
+    {
+        pthread_mutexattr_setpshared(&mutex_attr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&mutex_attr, PTHREAD_MUTEX_ROBUST);
+    }
+    pthread_mutex_init(&queue_name->queue_mutex, &mutex_attr);
+    pthread_mutexattr_destroy(&mutex_attr);
+
+    // 初始化条件变量, 超时等待使用CLOCK_MONOTONIC时钟, 不受系统时间调整影响
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    if (queue_name->flags & QUEUE_FLAG_SHARED)
+    {
+        pthread_condattr_setpshared(&cond_attr, PTHREAD_PROCESS_SHARED);
+    }
+    pthread_cond_init(&queue_name->queue_cond, &cond_attr);
+    pthread_cond_init(&queue_name->not_full_cond, &cond_attr);
+    pthread_cond_init(&queue_name->range_cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+
+    return true;
+}
+
+/**
+ * @brief  分配缓冲区并初始化队列成员
+ * @param  queue_name: 输出参数, 队列名
+ * @param  len       : 输入参数, 缓冲区的总大小
+ * @param  attr      : 输入参数, 队列属性
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool queue_init_common(queue_t *queue_name, const uint32_t len, const queue_attr_t *attr)
+{
+    memset(queue_name, 0, sizeof(queue_t));
+    queue_name->get_event_fd = -1;
+    queue_name->put_event_fd = -1;
+
+    // 分配内存空间(进程间共享队列和持久化队列的缓冲区紧跟在共享头部之后, 无需分配)
+    if (attr->flags & QUEUE_FLAG_MIRROR)
+    {
+        queue_name->data = queue_sys_mirror_map(len);
+    }
+    else if (!(attr->flags & (QUEUE_FLAG_SHARED | QUEUE_FLAG_PERSIST)))
+    {
+        queue_name->data = (uint8_t *)malloc(len);
+    }
+    if ((!queue_name->data) && (!(attr->flags & (QUEUE_FLAG_SHARED | QUEUE_FLAG_PERSIST))))
+    {
+        return false;
+    }
+
+    queue_name->total_size = len;
+    queue_name->flags = attr->flags;
+    queue_name->element_size = attr->element_size;
+    if (attr->flags & QUEUE_FLAG_POW2)
+    {
+        queue_name->mask = (len - 1);
+    }
+
+    queue_name->wait_policy = attr->wait_policy;
+    queue_name->spin_count = attr->spin_count;
+    queue_name->max_spin_ns = attr->max_spin_ns;
+    queue_name->overflow_policy = attr->overflow_policy;
+
+    if (!queue_init_runtime(queue_name))
+    {
+        queue_free_buffer(queue_name);
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  恢复持久化队列: 校验文件中的队列信息, 保留头尾指针, 重新初始化互斥锁和条件变量
+ *         只检查队列信息, 不读取缓冲区中的数据, 消息在读取时再校验
+ * @param  shared  : 输出参数, 映射的文件
+ * @param  map_size: 输入参数, 文件大小
+ * @return true : 成功
+ * @return false: 不是持久化队列文件或队列信息不一致
+ */
+static bool queue_recover_persistent(queue_shared_t *shared, const uint32_t map_size)
+{
+    queue_t *queue_name = &shared->queue;
+    uint32_t total_size = queue_name->total_size;
+    if ((QUEUE_PERSIST_MAGIC != shared->magic) || (map_size != shared->map_size) ||
+        (total_size != (map_size - QUEUE_SHARED_DATA_OFFSET)) || (!(queue_name->flags & QUEUE_FLAG_PERSIST)) ||
+        (!(queue_name->flags & QUEUE_FLAG_MSG)) || (queue_name->wait_policy > QUEUE_WAIT_BUSY_POLL) ||
+        (queue_name->overflow_policy > QUEUE_OVERFLOW_OVERWRITE) || (queue_name->element_size > 0) ||
+        (queue_name->max_size > 0) || (queue_name->flags & (QUEUE_FLAG_FUTEX | QUEUE_FLAG_MIRROR | QUEUE_FLAG_SHARED)))
+    {
+        return false;
+    }
+
+    // 头尾指针必须在缓冲区范围内
+    uint32_t head = queue_name->head;
+    uint32_t tail = queue_name->tail;
+    uint32_t current_size = 0;
+    if (queue_name->flags & QUEUE_FLAG_POW2)
+    {
+        if ((0 == total_size) || (total_size & (total_size - 1)) || ((tail - head) > total_size))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        if ((head >= total_size) || (tail >= total_size))
+        {
+            return false;
+        }
+
+        // 当前大小与头尾指针分别写入, 进程在两次写入之间退出时不一致
+        // 普通模式下有一个间隔元素, 头尾指针相等只表示队列为空, 当前大小可以由头尾指针唯一确定
+        current_size = ((tail >= head) ? (tail - head) : (total_size - head + tail));
+    }
+
+    // 当前大小由头尾指针推导, 重复写入不影响再次恢复
+    if (!(queue_name->flags & QUEUE_FLAG_POW2))
+    {
+        queue_name->current_size = current_size;
+    }
+
+    // 上次运行的等待者、预留和互斥锁状态都已失效, 只重新初始化运行时状态
+    // 不能清零整个队列信息再恢复头尾指针, 期间进程退出会使文件再也无法恢复
+    queue_name->data = NULL;
+
+    return queue_init_runtime(queue_name);
+}
+
+/**
+ * @brief  初始化循环队列
+ * @param  queue_name: 输出参数, 队列名
+ * @param  queue_size: 输入参数, 队列缓冲区的总大小
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_init(queue_t *queue_name, const uint32_t queue_size)
+{
+    queue_attr_t attr = {0};
+    queue_attr_init(&attr);
+
+    return queue_init_with_attr(queue_name, queue_size, &attr);
+}
+
+/**
+ * @brief  以2的幂容量模式初始化循环队列
+ *         容量向上取整为2的幂, 缓冲区全部可用, 读写时使用掩码代替取模
+ * @param  queue_name: 输出参数, 队列名
+ * @param  queue_size: 输入参数, 队列最小容量(不能超过2^31)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_init_pow2(queue_t *queue_name, const uint32_t queue_size)
+{
+    queue_attr_t attr = {0};
+    queue_attr_init(&attr);
+    attr.flags = QUEUE_FLAG_POW2;
+
+    return queue_init_with_attr(queue_name, queue_size, &attr);
+}
+
+/**
+ * @brief  初始化固定大小元素队列
+ *         读写以元素为单位, 缓冲区大小是元素大小的整数倍, 元素不会跨越缓冲区末尾
+ * @param  queue_name  : 输出参数, 队列名
+ * @param  element_size: 输入参数, 元素大小
+ * @param  queue_size  : 输入参数, 队列容量(元素个数)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_init_elem(queue_t *queue_name, const uint32_t element_size, const uint32_t queue_size)
+{
+    if (!element_size)
+    {
+        return false;
+    }
+
+    queue_attr_t attr = {0};
+    queue_attr_init(&attr);
+    attr.element_size = element_size;
+
+    return queue_init_with_attr(queue_name, queue_size, &attr);
+}
+
+/**
+ * @brief  初始化队列属性为默认值
+ * @param  attr: 输出参数, 队列属性
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_attr_init(queue_attr_t *attr)
+{
+    if (!attr)
+    {
+        return false;
+    }
+
+    memset(attr, 0, sizeof(queue_attr_t));
+
+    attr->wait_policy = QUEUE_WAIT_BLOCK;
+    attr->spin_count = QUEUE_DEFAULT_SPIN_COUNT;
+    attr->max_spin_ns = QUEUE_DEFAULT_MAX_SPIN_NS;
+    attr->sync_policy = QUEUE_SYNC_NONE;
+    attr->sync_interval = QUEUE_DEFAULT_SYNC_INTERVAL;
+    attr->overflow_policy = QUEUE_OVERFLOW_TRUNCATE;
+    attr->max_size = 0;
+    attr->shrink_delay = QUEUE_DEFAULT_SHRINK_DELAY;
+
+    return true;
+}
+
+/**
+ * @brief  按指定属性初始化循环队列
+ * @param  queue_name: 输出参数, 队列名
+ * @param  queue_size: 输入参数, 队列容量(2的幂模式下向上取整为2的幂, 不能超过2^31)
+ * @param  attr      : 输入参数, 队列属性
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_init_with_attr(queue_t *queue_name, const uint32_t queue_size, const queue_attr_t *attr)
+{
+    uint32_t len = 0;
+    uint32_t max_len = 0;
+
+    // 进程间共享队列和持久化队列只能由对应的接口创建
+    if ((!queue_name) || (!attr) || (attr->flags & (QUEUE_FLAG_SHARED | QUEUE_FLAG_PERSIST)) ||
+        (!queue_get_buffer_size(queue_size, attr, &len)))
+    {
+        return false;
+    }
+
+    // 自动扩容的最大容量不能小于初始容量, 且同样不能超出范围
+    if ((attr->max_size > 0) &&
+        ((attr->max_size < queue_size) || (!queue_get_buffer_size(attr->max_size, attr, &max_len))))
+    {
+        return false;
+    }
+
+    if (!queue_init_common(queue_name, len, attr))
+    {
+        return false;
+    }
+
+    queue_name->min_size = queue_size;
+    queue_name->max_size = attr->max_size;
+    queue_name->shrink_delay = attr->shrink_delay;
+
+    return true;
+}
+
+/**
+ * @brief  创建进程间共享队列(默认属性)
+ *         队列和缓冲区放在名为name的POSIX共享内存中, 其他进程调用queue_open_shared()打开后直接读写, 无需内核拷贝
+ * @param  name      : 输入参数, 共享内存名称(以'/'开头, 如"/my_queue", 已存在时失败)
+ * @param  queue_size: 输入参数, 队列缓冲区的总大小
+ * @return 成功: 队列指针(指向共享内存)
+ *         失败: NULL
+ */
+queue_t *queue_init_shared(const char *name, const uint32_t queue_size)
+{
+    queue_attr_t attr = {0};
+    queue_attr_init(&attr);
+
+    return queue_init_shared_with_attr(name, queue_size, &attr);
+}
+
+/**
+ * @brief  按指定属性创建进程间共享队列
+ *         互斥锁和条件变量设置为进程间共享, 互斥锁为健壮锁, 持有锁的进程退出后其他进程仍可加锁
+ * @param  name      : 输入参数, 共享内存名称(以'/'开头, 如"/my_queue", 已存在时失败)
+ * @param  queue_size: 输入参数, 队列容量(2的幂模式下向上取整为2的幂, 不能超过2^31)
+ * @param  attr      : 输入参数, 队列属性(不支持QUEUE_FLAG_FUTEX, QUEUE_FLAG_MIRROR和事件fd)
+ * @return 成功: 队列指针(指向共享内存)
+ *         失败: NULL
+ */
+queue_t *queue_init_shared_with_attr(const char *name, const uint32_t queue_size, const queue_attr_t *attr)
+{
+    uint32_t len = 0;
+
+    // futex等待使用进程私有的唤醒, 镜像映射和事件fd只在创建进程中有效
+    if ((!name) || (!attr) ||
+        (attr->flags & (QUEUE_FLAG_FUTEX | QUEUE_FLAG_MIRROR | QUEUE_FLAG_GET_FD | QUEUE_FLAG_PUT_FD |
+                        QUEUE_FLAG_SHARED | QUEUE_FLAG_PERSIST)) ||
+        (!queue_get_buffer_size(queue_size, attr, &len)) || ((QUEUE_SHARED_DATA_OFFSET + len) > UINT32_MAX))
+    {
+        return NULL;
+    }
+
+    int fd = shm_open(name, (O_RDWR | O_CREAT | O_EXCL), 0600);
+    if (-1 == fd)
+    {
+        return NULL;
+    }
+
+    uint32_t map_size = (uint32_t)(QUEUE_SHARED_DATA_OFFSET + len);
+    if (-1 == ftruncate(fd, map_size))
+    {
+        close(fd);
+        shm_unlink(name);
+
+        return NULL;
+    }
+
+    queue_shared_t *shared = (queue_shared_t *)mmap(NULL, map_size, (PROT_READ | PROT_WRITE), MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == shared)
+    {
+        shm_unlink(name);
+
+        return NULL;
+    }
+
+    queue_attr_t shared_attr = *attr;
+    shared_attr.flags |= QUEUE_FLAG_SHARED;
+    if (!queue_init_common(&shared->queue, len, &shared_attr))
+    {
+        munmap(shared, map_size);
+        shm_unlink(name);
+
+        return NULL;
+    }
+    shared->map_size = map_size;
+
+    // 初始化完成后才写入标志, 打开的进程据此判断队列是否可用
+    __atomic_store_n(&shared->magic, QUEUE_SHARED_MAGIC, __ATOMIC_RELEASE);
+
+    return &shared->queue;
+}
+
+/**
+ * @brief  打开其他进程创建的进程间共享队列
+ * @param  name: 输入参数, 共享内存名称(与创建时一致)
+ * @return 成功: 队列指针(指向共享内存)
+ *         失败: NULL(不存在或还未初始化完成)
+ */
+queue_t *queue_open_shared(const char *name)
+{
+    if (!name)
+    {
+        return NULL;
+    }
+
+    int fd = shm_open(name, O_RDWR, 0);
+    if (-1 == fd)
+    {
+        return NULL;
+    }
+
+    struct stat st = {0};
+    if ((-1 == fstat(fd, &st)) || (st.st_size < (off_t)QUEUE_SHARED_DATA_OFFSET) || (st.st_size > UINT32_MAX))
+    {
+        close(fd);
+
+        return NULL;
+    }
+
+    queue_shared_t *shared =
+        (queue_shared_t *)mmap(NULL, (size_t)st.st_size, (PROT_READ | PROT_WRITE), MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == shared)
+    {
+        return NULL;
+    }
+
+    if ((QUEUE_SHARED_MAGIC != __atomic_load_n(&shared->magic, __ATOMIC_ACQUIRE)) ||
+        (shared->map_size != (uint32_t)st.st_size))
+    {
+        munmap(shared, (size_t)st.st_size);
+
+        return NULL;
+    }
+
+    return &shared->queue;
+}
+
+/**
+ * @brief  关闭进程间共享队列(只解除本进程的映射, 其他进程仍可继续使用)
+ * @param  queue_name: 输入参数, 队列指针(queue_init_shared()或queue_open_shared()的返回值)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_close_shared(queue_t *queue_name)
+{
+    if ((!queue_name) || (!(queue_name->flags & QUEUE_FLAG_SHARED)))
+    {
+        return false;
+    }
+
+    queue_shared_t *shared = (queue_shared_t *)queue_name;
+
+    return (0 == munmap(shared, shared->map_size));
+}
+
+/**
+ * @brief  删除进程间共享队列的名称, 所有进程关闭后释放共享内存
+ * @param  name: 输入参数, 共享内存名称
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_unlink_shared(const char *name)
+{
+    if (!name)
+    {
+        return false;
+    }
+
+    return (0 == shm_unlink(name));
+}
+
+/**
+ * @brief  打开持久化队列(默认属性), 文件不存在时创建
+ *         队列和缓冲区映射到文件, 进程重启后打开同一个文件即可恢复未读取的消息
+ * @param  path      : 输入参数, 文件路径
+ * @param  queue_size: 输入参数, 队列缓冲区的总大小(恢复已有文件时使用文件中的大小)
+ * @return 成功: 队列指针(指向文件映射)
+ *         失败: NULL
+ */
+queue_t *queue_init_persistent(const char *path, const uint32_t queue_size)
+{
+    queue_attr_t attr = {0};
+    queue_attr_init(&attr);
+
+    return queue_init_persistent_with_attr(path, queue_size, &attr);
+}
+
+/**
+ * @brief  按指定属性打开持久化队列, 文件不存在时创建
+ *         持久化队列为消息模式, 每条消息带校验和; 恢复时只校验队列信息, 不读取缓冲区, 耗时与数据量无关
+ *         队列读取后头指针不一定立即写入文件, 系统掉电时可能重复读取最近的消息
+ * @param  path      : 输入参数, 文件路径(同一时刻只能被一个队列打开)
+ * @param  queue_size: 输入参数, 队列容量(恢复已有文件时使用文件中的容量和属性)
+ * @param  attr      : 输入参数, 队列属性(sync_policy指定同步策略, 不支持QUEUE_FLAG_FUTEX, QUEUE_FLAG_MIRROR和固定大小元素)
+ * @return 成功: 队列指针(指向文件映射)
+ *         失败: NULL(参数错误, 文件已被打开或文件中的队列信息不一致)
+ */
+queue_t *queue_init_persistent_with_attr(const char *path, const uint32_t queue_size, const queue_attr_t *attr)
+{
+    uint32_t len = 0;
+
+    if ((!path) || (!attr) || (attr->element_size > 0) || (attr->sync_policy > QUEUE_SYNC_COMMIT) ||
+        (attr->flags & (QUEUE_FLAG_FUTEX | QUEUE_FLAG_MIRROR | QUEUE_FLAG_SHARED | QUEUE_FLAG_PERSIST)))
+    {
+        return NULL;
+    }
+
+    queue_attr_t persist_attr = *attr;
+    persist_attr.flags |= (QUEUE_FLAG_PERSIST | QUEUE_FLAG_MSG);
+    if ((!queue_get_buffer_size(queue_size, &persist_attr, &len)) || ((QUEUE_SHARED_DATA_OFFSET + len) > UINT32_MAX))
+    {
+        return NULL;
+    }
+
+    int fd = open(path, (O_RDWR | O_CREAT | O_CLOEXEC), 0600);
+    if (-1 == fd)
+    {
+        return NULL;
+    }
+
+    // 两个队列同时映射同一个文件会破坏队列信息, 文件锁随文件描述符关闭或进程退出释放
+    struct stat st = {0};
+    if ((-1 == flock(fd, (LOCK_EX | LOCK_NB))) || (-1 == fstat(fd, &st)) ||
+        ((st.st_size > 0) && ((st.st_size < (off_t)QUEUE_SHARED_DATA_OFFSET) || (st.st_size > UINT32_MAX))))
+    {
+        close(fd);
+
+        return NULL;
+    }
+
+    // 文件标志为0说明上次创建时未完成初始化, 与新文件一样处理, 不受上次请求的容量影响
+    uint32_t magic = 0;
+    if ((st.st_size > 0) && (sizeof(magic) != pread(fd, &magic, sizeof(magic), offsetof(queue_shared_t, magic))))
+    {
+        close(fd);
+
+        return NULL;
+    }
+
+    // 新文件按指定容量扩展, 已有文件按原大小映射
+    bool create = (0 == magic);
+    uint32_t map_size = (create ? (uint32_t)(QUEUE_SHARED_DATA_OFFSET + len) : (uint32_t)st.st_size);
+    if ((create) && (-1 == ftruncate(fd, map_size)))
+    {
+        close(fd);
+
+        return NULL;
+    }
+
+    queue_shared_t *shared = (queue_shared_t *)mmap(NULL, map_size, (PROT_READ | PROT_WRITE), MAP_SHARED, fd, 0);
+    if (MAP_FAILED == shared)
+    {
+        close(fd);
+
+        return NULL;
+    }
+
+    bool ret = false;
+    if (create)
+    {
+        ret = queue_init_common(&shared->queue, len, &persist_attr);
+        shared->map_size = map_size;
+
+        // 队列信息写入文件后才写入文件标志
+        msync(shared, map_size, MS_SYNC);
+        shared->magic = QUEUE_PERSIST_MAGIC;
+    }
+    else
+    {
+        ret = queue_recover_persistent(shared, map_size);
+    }
+    if (!ret)
+    {
+        munmap(shared, map_size);
+        close(fd);
+
+        return NULL;
+    }
+
+    shared->lock_fd = fd;
+    shared->sync_policy = attr->sync_policy;
+    shared->sync_interval = attr->sync_interval;
+    shared->last_sync_ns = queue_sys_get_time_ns(CLOCK_MONOTONIC);
+    msync(shared, map_size, MS_SYNC);
+
+    return &shared->queue;
+}
+
+/**
+ * @brief  立即将持久化队列同步到文件
+ * @param  queue_name: 输入参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_sync_persistent(queue_t *queue_name)
+{
+    if ((!queue_name) || (!(queue_name->flags & QUEUE_FLAG_PERSIST)))
+    {
+        return false;
+    }
+
+    queue_shared_t *shared = (queue_shared_t *)queue_name;
+    __atomic_store_n(&shared->last_sync_ns, queue_sys_get_time_ns(CLOCK_MONOTONIC), __ATOMIC_RELAXED);
+
+    return (0 == msync(shared, shared->map_size, MS_SYNC));
+}
+
+/**
+ * @brief  关闭持久化队列, 关闭前同步到文件, 未读取的消息保留在文件中
+ * @param  queue_name: 输入参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_close_persistent(queue_t *queue_name)
+{
+    if ((!queue_name) || (!(queue_name->flags & QUEUE_FLAG_PERSIST)))
+    {
+        return false;
+    }
+
+    queue_close_events(queue_name);
+
+    queue_shared_t *shared = (queue_shared_t *)queue_name;
+    int fd = shared->lock_fd;
+    uint32_t map_size = shared->map_size;
+    bool ret = (0 == msync(shared, map_size, MS_SYNC));
+    munmap(shared, map_size);
+    close(fd);
+
+    return ret;
+}
+
+/**
+ * @brief  清空队列
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_clear(queue_t *queue_name)
+{
+    if (!queue_name)
+    {
+        return false;
+    }
+
+    queue_lock(queue_name);
+
+    queue_name->head = queue_name->tail = 0;
+    queue_name->current_size = 0;
+
+    // 未提交的预留空间和未释放的消费者视图一并取消
+    queue_name->put_reserved = 0;
+    queue_name->get_viewed = 0;
+
+    // 队列空间全部释放, 唤醒所有等待的生产者
+    if (queue_name->put_waiters > 0)
+    {
+        pthread_cond_broadcast(&queue_name->not_full_cond);
+    }
+
+    queue_name->put_event_need = 0;
+    queue_update_events(queue_name);
+
+    pthread_mutex_unlock(&queue_name->queue_mutex);
+
+    return true;
+}
+
+/**
+ * @brief  调整队列容量, 在一次加锁中重新分配缓冲区, 并把已有数据按顺序拷贝到新缓冲区开头
+ *         等待中的生产者和消费者不受影响, 扩容后唤醒等待空间的生产者
+ * @param  queue_name: 输出参数, 队列名
+ * @param  queue_size: 输入参数, 新的队列容量(与初始化时单位相同, 2的幂模式下向上取整为2的幂)
+ * @return true : 成功
+ * @return false: 失败(进程间共享队列和持久化队列, 新容量放不下已有数据, 有未提交的预留或未释放的视图, 或内存不足)
+ */
+bool queue_resize(queue_t *queue_name, const uint32_t queue_size)
+{
+    // 进程间共享队列和持久化队列的缓冲区大小由映射决定
+    if ((!queue_name) || (!queue_size) || (queue_name->flags & (QUEUE_FLAG_SHARED | QUEUE_FLAG_PERSIST)))
+    {
+        return false;
+    }
+
+    queue_lock(queue_name);
+
+    bool ret = queue_resize_locked(queue_name, queue_size);
+
+    queue_unlock(queue_name);
+
+    return ret;
+}
+
+/**
+ * @brief  获取队列当前元素个数
+ * @param  queue_name: 输入参数, 队列名
+ * @return 队列当前元素个数(固定大小元素队列为元素个数, 其他队列为字节数)
+ */
+uint32_t queue_get_current_size(queue_t queue_name)
+{
+    if (queue_name.element_size > 0)
+    {
+        return (queue_get_used_size(&queue_name) / queue_name.element_size);
+    }
+
+    return queue_get_used_size(&queue_name);
+}
+
+/**
+ * @brief  写入数据到循环队列, 空间不足时按队列的溢出策略处理
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return 成功: 实际插入个数(覆盖最旧数据策略下为data_len, 拒绝写入策略下空间不足时为0)
+ *         失败: -1
+ */
+int queue_put_data(queue_t *queue_name, const uint8_t *data, const uint32_t data_len)
+{
+    // 实际插入个数
+    uint32_t put_num = 0;
+
+    if ((!queue_name) || (!data) || (!data_len) || (!queue_is_byte_stream(queue_name)))
+    {
+        return -1;
+    }
+
+    queue_lock(queue_name);
+
+    put_num = queue_write_policy_locked(queue_name, data, data_len);
+
+    queue_unlock(queue_name);
+
+    return put_num;
+}
+
+/**
+ * @brief  阻塞方式写入数据到循环队列(队列满时等待消费者释放空间, 直到全部写入)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return 成功: 实际插入个数
+ *         失败: -1
+ */
+int queue_put_data_blocking(queue_t *queue_name, const uint8_t *data, const uint32_t data_len)
+{
+    if ((!queue_name) || (!data) || (!data_len) || (!queue_is_byte_stream(queue_name)))
+    {
+        return -1;
+    }
+
+    return queue_write_wait(queue_name, data, data_len, NULL);
+}
+
+/**
+ * @brief  超时方式写入数据到循环队列(超时时间为0, 直接写入队列)
+ *         队列满时等待消费者释放空间, 直到全部写入或超时
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际插入个数
+ *         失败: -1(超时且未写入任何数据)
+ */
+int queue_put_data_with_timeout(queue_t *queue_name, const uint8_t *data, const uint32_t data_len,
+                                const uint32_t timeout)
+{
+    if ((!queue_name) || (!data) || (!data_len) || (!queue_is_byte_stream(queue_name)))
+    {
+        return -1;
+    }
+
+    if (0 == timeout)
+    {
+        return queue_put_data(queue_name, data, data_len);
+    }
+
+    // 等待信号的结束时间
+    struct timespec end_time = {0};
+    queue_sys_deadline_after_ms(&end_time, timeout);
+
+    return queue_write_wait(queue_name, data, data_len, &end_time);
+}
+
+/**
+ * @brief  整体写入数据到循环队列(空闲空间不足时不写入任何数据)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return 成功: 插入个数(等于待插入数据长度, 空闲空间不足时为0)
+ *         失败: -1(参数错误或数据长度超过队列容量)
+ */
+int queue_put_data_all(queue_t *queue_name, const uint8_t *data, const uint32_t data_len)
+{
+    if ((!queue_name) || (!data) || (!data_len) || (!queue_is_byte_stream(queue_name)))
+    {
+        return -1;
+    }
+
+    queue_lock(queue_name);
+
+    // 数据超过队列容量, 永远无法整体写入
+    if (data_len > queue_get_max_capacity(queue_name))
+    {
+        pthread_mutex_unlock(&queue_name->queue_mutex);
+
+        return -1;
+    }
+
+    bool ret = queue_write_all_locked(queue_name, data, data_len);
+
+    queue_unlock(queue_name);
+
+    return (ret ? (int)data_len : 0);
+}
+
+/**
+ * @brief  阻塞方式整体写入数据到循环队列(空闲空间不足时等待, 直到可以一次全部写入)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return 成功: 插入个数(等于待插入数据长度)
+ *         失败: -1(参数错误或数据长度超过队列容量)
+ */
+int queue_put_data_all_blocking(queue_t *queue_name, const uint8_t *data, const uint32_t data_len)
+{
+    if ((!queue_name) || (!data) || (!data_len) || (!queue_is_byte_stream(queue_name)))
+    {
+        return -1;
+    }
+
+    return queue_write_all_wait(queue_name, data, data_len, NULL);
+}
+
+/**
+ * @brief  超时方式整体写入数据到循环队列(超时时间为0, 直接写入队列)
+ *         空闲空间不足时等待, 直到可以一次全部写入或超时, 超时时不写入任何数据
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 插入个数(等于待插入数据长度, 超时时间为0且空闲空间不足时为0)
+ *         失败: -1(参数错误, 数据长度超过队列容量或超时)
+ */
+int queue_put_data_all_with_timeout(queue_t *queue_name, const uint8_t *data, const uint32_t data_len,
+                                    const uint32_t timeout)
+{
+    if ((!queue_name) || (!data) || (!data_len) || (!queue_is_byte_stream(queue_name)))
+    {
+        return -1;
+    }
+
+    if (0 == timeout)
+    {
+        return queue_put_data_all(queue_name, data, data_len);
+    }
+
+    // 等待信号的结束时间
+    struct timespec end_time = {0};
+    queue_sys_deadline_after_ms(&end_time, timeout);
+
+    return queue_write_all_wait(queue_name, data, data_len, &end_time);
+}
+
+/**
+ * @brief  预留队列空闲空间, 生产者直接向返回的片段写入数据, 再调用queue_put_commit()发布
+ *         同一时刻只能有一个未提交的预留, 预留期间其他写入操作视为队列已满
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data_len  : 输入参数, 需要预留的长度
+ * @param  seg1      : 输出参数, 第一段可写空间
+ * @param  seg2      : 输出参数, 第二段可写空间(空间不回绕时长度为0)
+ * @return 成功: 实际预留长度(队列已满时为0)
+ *         失败: -1(参数错误或已有未提交的预留)
+ */
+int queue_put_reserve(queue_t *queue_name, const uint32_t data_len, queue_segment_t *seg1, queue_segment_t *seg2)
+{
+    if ((!queue_name) || (!data_len) || (!seg1) || (!seg2) || (!queue_is_byte_stream(queue_name)))
+    {
+        return -1;
+    }
+
+    queue_lock(queue_name);
+
+    if (queue_name->put_reserved > 0)
+    {
+        pthread_mutex_unlock(&queue_name->queue_mutex);
+
+        return -1;
+    }
+
+    queue_grow_locked(queue_name, data_len);
+
+    uint32_t reserve_len = queue_get_free_size(queue_name);
+    if (reserve_len > data_len)
+    {
+        reserve_len = data_len;
+    }
+
+    queue_name->put_reserved = reserve_len;
+    queue_get_segments(queue_name, queue_name->tail, reserve_len, seg1, seg2);
+
+    // 预留期间其他写入视为队列已满
+    queue_update_events(queue_name);
+
+    pthread_mutex_unlock(&queue_name->queue_mutex);
+
+    return reserve_len;
+}
+
+/**
+ * @brief  提交预留空间中已写入的数据(提交长度可小于预留长度, 为0时取消预留)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data_len  : 输入参数, 提交长度
+ * @return 成功: 实际提交长度
+ *         失败: -1(参数错误或提交长度超过预留长度)
+ */
+int queue_put_commit(queue_t *queue_name, const uint32_t data_len)
+{
+    if (!queue_name)
+    {
+        return -1;
+    }
+
+    queue_lock(queue_name);
+
+    if (data_len > queue_name->put_reserved)
+    {
+        pthread_mutex_unlock(&queue_name->queue_mutex);
+
+        return -1;
+    }
+
+    queue_name->put_reserved = 0;
+
+    if (data_len > 0)
+    {
+        uint32_t used_size = queue_get_used_size(queue_name);
+
+        queue_advance_tail(queue_name, data_len);
+
+        queue_notify_put(queue_name, used_size, data_len);
+    }
+
+    // 预留期间等待的生产者可以继续写入
+    if ((queue_name->put_waiters > 0) && (queue_get_free_size(queue_name) > 0))
+    {
+        pthread_cond_signal(&queue_name->not_full_cond);
+    }
+
+    queue_update_events(queue_name);
+
+    queue_unlock(queue_name);
+
+    return data_len;
+}
+
+/**
+ * @brief  写入一条完整消息到消息模式队列(超时时间为0, 直接写入队列)
+ *         消息和长度头一次写入, 空间不足时不写入任何数据
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 消息内容
+ * @param  data_len  : 输入参数, 消息长度
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 消息长度(超时时间为0且空间不足时为0)
+ *         失败: -1(参数错误, 消息超过队列容量或超时)
+ */
+int queue_put_msg(queue_t *queue_name, const uint8_t *data, const uint32_t data_len, const uint32_t timeout)
+{
+    if ((!queue_name) || (!data) || (!data_len) || (!(queue_name->flags & QUEUE_FLAG_MSG)))
+    {
+        return -1;
+    }
+
+    queue_lock(queue_name);
+
+    // 消息超过队列容量, 永远无法写入
+    uint32_t capacity = queue_get_max_capacity(queue_name);
+    if ((data_len > capacity) || ((queue_msg_header_len(queue_name, data_len) + data_len) > capacity))
+    {
+        pthread_mutex_unlock(&queue_name->queue_mutex);
+
+        return -1;
+    }
+
+    if (timeout > 0)
+    {
+        // 等待信号的结束时间
+        struct timespec end_time = {0};
+        queue_sys_deadline_after_ms(&end_time, timeout);
+
+        if (!queue_wait_writable(queue_name, (queue_msg_header_len(queue_name, data_len) + data_len), &end_time))
+        {
+            queue_unlock(queue_name);
+
+            return -1;
+        }
+    }
+
+    // 不等待时按溢出策略处理空间不足(消息只能整条写入, 只写入能放下的部分与拒绝写入相同)
+    if ((0 == timeout) && (QUEUE_OVERFLOW_OVERWRITE == queue_name->overflow_policy))
+    {
+        queue_drop_msgs_locked(queue_name, (queue_msg_header_len(queue_name, data_len) + data_len));
+    }
+
+    bool ret = queue_write_msg_locked(queue_name, data, data_len);
+    if ((!ret) && (0 == timeout))
+    {
+        queue_name->dropped_bytes += data_len;
+    }
+
+    queue_unlock(queue_name);
+
+    if (ret)
+    {
+        queue_persist_sync(queue_name);
+    }
+
+    return (ret ? (int)data_len : 0);
+}
+
+/**
+ * @brief  阻塞方式从循环队列中获取数据
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @return 成功: 实际获取个数
+ *         失败: -1
+ */
+int queue_get_data(queue_t *queue_name, uint8_t *data, const uint32_t data_len)
+{
+    if ((!queue_name) || (!data) || (!data_len) || (!queue_is_byte_stream(queue_name)))
+    {
+        return -1;
+    }
+
+    return queue_read_wait(queue_name, data, data_len, NULL);
+}
+
+/**
+ * @brief  超时方式从循环队列中获取数据(超时时间为0, 直接从队列获取数据)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际获取个数
+ *         失败: -1
+ */
+int queue_get_data_with_timeout(queue_t *queue_name, uint8_t *data, const uint32_t data_len, const uint32_t timeout)
+{
+    // 实际获取个数
+    uint32_t get_num = 0;
+
+    if ((!queue_name) || (!data) || (!data_len) || (!queue_is_byte_stream(queue_name)))
+    {
+        return -1;
+    }
+
+    if (timeout > 0)
+    {
+        // 等待信号的结束时间
+        struct timespec end_time = {0};
+        queue_sys_deadline_after_ms(&end_time, timeout);
+
+        return queue_read_wait(queue_name, data, data_len, &end_time);
+    }
+
+    queue_lock(queue_name);
+
+    get_num = queue_read_locked(queue_name, data, data_len);
+
+    queue_unlock(queue_name);
+
+    return get_num;
+}
+
+/**
+ * @brief  按长度范围从循环队列中获取数据(超时时间为0, 直接获取)
+ *         等待队列中至少有min_len字节后, 最多拷贝max_len字节; 生产者只在数据量跨过等待的最小长度时唤醒
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  min_len   : 输入参数, 最小获取长度(不能超过队列容量)
+ * @param  max_len   : 输入参数, 最大获取长度(不能小于最小获取长度)
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际获取个数(超时时间为0且数据不足最小长度时为0)
+ *         失败: -1(参数错误或超时, 超时时不获取任何数据)
+ */
+int queue_get_data_range(queue_t *queue_name, uint8_t *data, const uint32_t min_len, const uint32_t max_len,
+                         const uint32_t timeout)
+{
+    if (0 == timeout)
+    {
+        return queue_read_range(queue_name, data, min_len, max_len, false, NULL);
+    }
+
+    // 等待信号的结束时间
+    struct timespec end_time = {0};
+    queue_sys_deadline_after_ms(&end_time, timeout);
+
+    return queue_read_range(queue_name, data, min_len, max_len, true, &end_time);
+}
+
+/**
+ * @brief  计算超时结束时间(CLOCK_MONOTONIC时钟, 不受系统时间调整影响)
+ *         循环读取时计算一次, 之后多次调用xxx_until()接口复用同一个结束时间
+ * @param  deadline  : 输出参数, 超时结束时间
+ * @param  timeout_ns: 输入参数, 超时时间(单位: ns)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_deadline_after_ns(struct timespec *deadline, const uint64_t timeout_ns)
+{
+    if (!deadline)
+    {
+        return false;
+    }
+
+    queue_sys_deadline_after_ns(deadline, timeout_ns);
+
+    return true;
+}
+
+/**
+ * @brief  指定结束时间从循环队列中获取数据(结束时间已过, 直接从队列获取数据)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @param  deadline  : 输入参数, 超时结束时间(CLOCK_MONOTONIC时钟, 为NULL时一直等待)
+ * @return 成功: 实际获取个数
+ *         失败: -1(参数错误或超时)
+ */
+int queue_get_data_until(queue_t *queue_name, uint8_t *data, const uint32_t data_len,
+                         const struct timespec *deadline)
+{
+    if ((!queue_name) || (!data) || (!data_len) || (!queue_is_byte_stream(queue_name)))
+    {
+        return -1;
+    }
+
+    return queue_read_wait(queue_name, data, data_len, deadline);
+}
+
+/**
+ * @brief  指定结束时间按长度范围从循环队列中获取数据
+ *         等待队列中至少有min_len字节后, 最多拷贝max_len字节
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  min_len   : 输入参数, 最小获取长度(不能超过队列容量)
+ * @param  max_len   : 输入参数, 最大获取长度(不能小于最小获取长度)
+ * @param  deadline  : 输入参数, 超时结束时间(CLOCK_MONOTONIC时钟, 为NULL时一直等待)
+ * @return 成功: 实际获取个数
+ *         失败: -1(参数错误或超时, 超时时不获取任何数据)
+ */
+int queue_get_data_range_until(queue_t *queue_name, uint8_t *data, const uint32_t min_len, const uint32_t max_len,
+                               const struct timespec *deadline)
+{
+    return queue_read_range(queue_name, data, min_len, max_len, true, deadline);
+}
+
+/**
+ * @brief  获取消费者视图, 返回指向队列数据的片段, 不移动队列头指针(超时时间为0, 直接获取)
+ *         处理完成后调用queue_get_release()释放, 同一时刻只能有一个未释放的视图, 视图未释放期间其他读取操作视为队列为空
+ * @param  queue_name: 输出参数, 队列名
+ * @param  seg1      : 输出参数, 第一段可读数据
+ * @param  seg2      : 输出参数, 第二段可读数据(数据不回绕时长度为0)
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 可读数据总长度(超时时间为0且队列为空时为0)
+ *         失败: -1(参数错误, 已有未释放的视图或超时)
+ */
+int queue_get_view(queue_t *queue_name, queue_segment_t *seg1, queue_segment_t *seg2, const uint32_t timeout)
+{
+    if ((!queue_name) || (!seg1) || (!seg2) || (!queue_is_byte_stream(queue_name)))
+    {
+        return -1;
+    }
+
+    queue_lock(queue_name);
+
+    if (queue_name->get_viewed > 0)
+    {
+        pthread_mutex_unlock(&queue_name->queue_mutex);
+
+        return -1;
+    }
+
+    if (timeout > 0)
+    {
+        // 等待信号的结束时间
+        struct timespec end_time = {0};
+        queue_sys_deadline_after_ms(&end_time, timeout);
+
+        if (!queue_wait_readable(queue_name, 1, &end_time))
+        {
+            queue_unlock(queue_name);
+
+            return -1;
+        }
+    }
+
+    // 视图覆盖当前全部数据, 之后写入的数据不在视图内
+    uint32_t view_len = queue_get_readable_size(queue_name);
+    __atomic_store_n(&queue_name->get_viewed, view_len, __ATOMIC_RELAXED);
+    queue_get_segments(queue_name, queue_name->head, view_len, seg1, seg2);
+
+    queue_unlock(queue_name);
+
+    return view_len;
+}
+
+/**
+ * @brief  释放消费者视图中已处理的数据(释放长度可小于视图长度, 为0时只结束视图不消费数据)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data_len  : 输入参数, 释放长度
+ * @return 成功: 实际释放长度
+ *         失败: -1(参数错误或释放长度超过视图长度)
+ */
+int queue_get_release(queue_t *queue_name, const uint32_t data_len)
+{
+    if (!queue_name)
+    {
+        return -1;
+    }
+
+    queue_lock(queue_name);
+
+    if (data_len > queue_name->get_viewed)
+    {
+        pthread_mutex_unlock(&queue_name->queue_mutex);
+
+        return -1;
+    }
+
+    __atomic_store_n(&queue_name->get_viewed, 0, __ATOMIC_RELAXED);
+
+    uint32_t used_size = queue_get_used_size(queue_name);
+    if (data_len > 0)
+    {
+        queue_advance_head(queue_name, data_len);
+    }
+
+    // 视图期间队列集合判断为不可读, 释放后还有剩余数据时唤醒所属队列集合
+    if (used_size > data_len)
+    {
+        queue_wake_set(queue_name);
+    }
+
+    // 视图期间等待的消费者可以继续读取剩余数据
+    queue_notify_get(queue_name, used_size, data_len);
+
+    queue_unlock(queue_name);
+
+    return data_len;
+}
+
+/**
+ * @brief  写入元素到固定大小元素队列(超时时间为0, 直接写入队列, 空间不足时按队列的溢出策略处理)
+ *         队列满时等待消费者释放空间, 直到全部写入或超时
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入元素
+ * @param  elem_num  : 输入参数, 待插入元素个数
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际插入元素个数
+ *         失败: -1(参数错误或超时且未写入任何元素)
+ */
+int queue_put_elem(queue_t *queue_name, const void *data, const uint32_t elem_num, const uint32_t timeout)
+{
+    if ((!queue_name) || (!data) || (!elem_num) || (!queue_name->element_size) ||
+        (elem_num > (UINT32_MAX / queue_name->element_size)))
+    {
+        return -1;
+    }
+
+    uint32_t data_len = (elem_num * queue_name->element_size);
+    int put_num = 0;
+
+    if (0 == timeout)
+    {
+        queue_lock(queue_name);
+
+        put_num = queue_write_policy_locked(queue_name, (const uint8_t *)data, data_len);
+
+        queue_unlock(queue_name);
+    }
+    else
+    {
+        // 等待信号的结束时间
+        struct timespec end_time = {0};
+        queue_sys_deadline_after_ms(&end_time, timeout);
+
+        put_num = queue_write_wait(queue_name, (const uint8_t *)data, data_len, &end_time);
+    }
+
+    return ((put_num > 0) ? (int)(put_num / queue_name->element_size) : put_num);
+}
+
+/**
+ * @brief  从固定大小元素队列中获取元素(超时时间为0, 直接获取)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的元素
+ * @param  elem_num  : 输入参数, 指定获取元素个数
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际获取元素个数(超时时间为0且队列为空时为0)
+ *         失败: -1(参数错误或超时)
+ */
+int queue_get_elem(queue_t *queue_name, void *data, const uint32_t elem_num, const uint32_t timeout)
+{
+    if ((!queue_name) || (!data) || (!elem_num) || (!queue_name->element_size) ||
+        (elem_num > (UINT32_MAX / queue_name->element_size)))
+    {
+        return -1;
+    }
+
+    uint32_t data_len = (elem_num * queue_name->element_size);
+    int get_num = 0;
+
+    if (0 == timeout)
+    {
+        queue_lock(queue_name);
+
+        get_num = queue_read_locked(queue_name, (uint8_t *)data, data_len);
+
+        queue_unlock(queue_name);
+    }
+    else
+    {
+        // 等待信号的结束时间
+        struct timespec end_time = {0};
+        queue_sys_deadline_after_ms(&end_time, timeout);
+
+        get_num = queue_read_wait(queue_name, (uint8_t *)data, data_len, &end_time);
+    }
+
+    return ((get_num > 0) ? (int)(get_num / queue_name->element_size) : get_num);
+}
 
 /**
- * @brief  初始化循环队列
- * @param  queue_name: 输出参数, 队列名
- * @param  queue_size: 输入参数, 队列缓冲区的总大小
- * @return true : 成功
- * @return false: 失败
+ * @brief  获取消息模式队列中下一条消息的长度(不消费消息)
+ * @param  queue_name: 输入参数, 队列名
+ * @return 成功: 下一条消息的长度(队列为空, 或持久化队列校验失败丢弃数据时为0)
+ *         失败: -1
  */
-bool queue_init(queue_t *queue_name, const uint32_t queue_size)
+int queue_get_msg_size(queue_t *queue_name)
 {
-    if ((!queue_name) || (!queue_size))
+    if ((!queue_name) || (!(queue_name->flags & QUEUE_FLAG_MSG)))
     {
-        return false;
+        return -1;
     }
 
-    // 计算需要分配的内存空间
-    // 申请时, 需要多加一个间隔元素
-    uint32_t len = (queue_size * sizeof(uint8_t) + 1);
+    queue_lock(queue_name);
 
-    // 分配内存空间
-    queue_name->data = (uint8_t *)malloc(len);
-    if (!queue_name->data)
+    // 与读取消息使用相同的校验, 不会返回随后读取时被丢弃的消息长度
+    uint32_t used_size = queue_get_used_size(queue_name);
+    uint32_t header_len = 0;
+    uint32_t msg_len = queue_verify_msg_locked(queue_name, &header_len);
+    // 只有丢弃了数据时才唤醒生产者, 只查询长度不影响其他等待者和自动缩容
+    uint32_t release_len = (used_size - queue_get_used_size(queue_name));
+    if (release_len > 0)
     {
-        return false;
+        queue_notify_get(queue_name, used_size, release_len);
     }
 
-    queue_name->head = queue_name->tail = 0;
-    queue_name->total_size = len;
-    queue_name->current_size = 0;
+    queue_unlock(queue_name);
+
+    if (release_len > 0)
+    {
+        queue_persist_sync(queue_name);
+    }
 
-    // 初始化互斥锁
-    pthread_mutex_init(&queue_name->queue_mutex, NULL);
+    return msg_len;
+}
 
-    // 初始化条件变量
-    pthread_cond_init(&queue_name->queue_cond, NULL);
+/**
+ * @brief  从消息模式队列中获取一条完整消息(超时时间为0, 直接获取)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的消息
+ * @param  data_len  : 输入参数, 消息缓冲区大小
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 消息长度(超时时间为0且队列为空时为0)
+ *         失败: -1(参数错误, 超时或缓冲区不足, 缓冲区不足时消息保留在队列中)
+ */
+int queue_get_msg(queue_t *queue_name, uint8_t *data, const uint32_t data_len, const uint32_t timeout)
+{
+    queue_msg_t msg = {data, data_len, 0};
 
-    return true;
+    int ret = queue_get_msgs(queue_name, &msg, 1, timeout);
+    if (ret <= 0)
+    {
+        return ret;
+    }
+
+    return msg.len;
 }
 
 /**
- * @brief  清空队列
+ * @brief  从消息模式队列中批量获取消息, 只加锁一次(超时时间为0, 直接获取)
+ *         只等待第一条消息, 之后队列为空或消息超过对应缓冲区大小时停止
  * @param  queue_name: 输出参数, 队列名
- * @return true : 成功
- * @return false: 失败
+ * @param  msgs      : 输出参数, 消息缓冲区数组, 获取到的消息长度保存在len中
+ * @param  msg_num   : 输入参数, 消息缓冲区个数
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 获取到的消息个数(超时时间为0且队列为空时为0)
+ *         失败: -1(参数错误, 超时或第一条消息超过缓冲区大小)
  */
-bool queue_clear(queue_t *queue_name)
+int queue_get_msgs(queue_t *queue_name, queue_msg_t *msgs, const uint32_t msg_num, const uint32_t timeout)
 {
-    if (!queue_name)
+    if ((!queue_name) || (!msgs) || (!msg_num) || (!(queue_name->flags & QUEUE_FLAG_MSG)))
     {
-        return false;
+        return -1;
     }
 
-    pthread_mutex_lock(&queue_name->queue_mutex);
+    queue_lock(queue_name);
 
-    queue_name->head = queue_name->tail = 0;
-    queue_name->current_size = 0;
+    if (timeout > 0)
+    {
+        // 等待信号的结束时间
+        struct timespec end_time = {0};
+        queue_sys_deadline_after_ms(&end_time, timeout);
 
-    pthread_mutex_unlock(&queue_name->queue_mutex);
+        if (!queue_wait_readable(queue_name, 1, &end_time))
+        {
+            queue_unlock(queue_name);
 
-    return true;
+            return -1;
+        }
+    }
+
+    // 全部消息读取完成后只唤醒一次
+    uint32_t used_size = queue_get_used_size(queue_name);
+    uint32_t get_num = 0;
+    int ret = 0;
+    while (get_num < msg_num)
+    {
+        ret = queue_read_msg_locked(queue_name, msgs[get_num].data, msgs[get_num].size);
+        if (ret <= 0)
+        {
+            break;
+        }
+
+        msgs[get_num].len = ret;
+        get_num++;
+    }
+
+    uint32_t release_len = (used_size - queue_get_used_size(queue_name));
+    queue_notify_get(queue_name, used_size, release_len);
+
+    queue_unlock(queue_name);
+
+    if (release_len > 0)
+    {
+        queue_persist_sync(queue_name);
+    }
+
+    if ((0 == get_num) && (-1 == ret))
+    {
+        return -1;
+    }
+
+    return get_num;
 }
 
 /**
- * @brief  获取队列当前元素个数
+ * @brief  获取可读事件fd(初始化时需设置QUEUE_FLAG_GET_FD标志)
+ *         队列由空变为非空时置位, 被读空时清除, 可加入epoll/poll/select监听可读事件
+ *         事件fd由队列维护, 调用者不需要读取, 也不能关闭
  * @param  queue_name: 输入参数, 队列名
- * @return 队列当前元素个数
+ * @return 成功: 可读事件fd
+ *         失败: -1(参数错误或未启用)
  */
-uint32_t queue_get_current_size(queue_t queue_name)
+int queue_get_fd(queue_t *queue_name)
 {
-    return queue_name.current_size;
+    if (!queue_name)
+    {
+        return -1;
+    }
+
+    return queue_name->get_event_fd;
 }
 
 /**
- * @brief  写入数据到循环队列
- * @param  queue_name: 输出参数, 队列名
- * @param  data      : 输入参数, 待插入数据
- * @param  data_len  : 输入参数, 待插入数据长度
- * @return 成功: 实际插入个数
- *         失败: -1
+ * @brief  获取可写事件fd(初始化时需设置QUEUE_FLAG_PUT_FD标志)
+ *         空闲空间不足时清除, 空闲空间满足上次失败的写入时置位, 可加入epoll/poll/select监听可读事件
+ *         事件fd由队列维护, 调用者不需要读取, 也不能关闭
+ * @param  queue_name: 输入参数, 队列名
+ * @return 成功: 可写事件fd
+ *         失败: -1(参数错误或未启用)
  */
-int queue_put_data(queue_t *queue_name, const uint8_t *data, const uint32_t data_len)
+int queue_get_put_fd(queue_t *queue_name)
 {
-    // 实际插入个数
-    uint32_t put_num = 0;
-
-    if ((!queue_name) || (!data) || (!data_len))
+    if (!queue_name)
     {
         return -1;
     }
 
-    pthread_mutex_lock(&queue_name->queue_mutex);
+    return queue_name->put_event_fd;
+}
 
-    // 数据循环插入队列, 并修改队尾指针
-    for (put_num = 0; put_num < data_len; put_num++)
+/**
+ * @brief  初始化队列集合
+ * @param  queue_set: 输出参数, 队列集合
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_set_init(queue_set_t *queue_set)
+{
+    if (!queue_set)
     {
-        // 每次插入数据前, 先判断队列是否已满
-        if ((queue_name->tail + 1) % queue_name->total_size == queue_name->head)
-        {
-            pthread_cond_signal(&queue_name->queue_cond);
+        return false;
+    }
 
-            pthread_mutex_unlock(&queue_name->queue_mutex);
+    memset(queue_set, 0, sizeof(queue_set_t));
 
-            return put_num;
-        }
+    return true;
+}
+
+/**
+ * @brief  添加队列到队列集合(一个队列只能属于一个集合, 不能与queue_set_wait()并发调用)
+ * @param  queue_set : 输出参数, 队列集合
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败(参数错误, 集合已满或队列已属于某个集合)
+ */
+bool queue_set_add(queue_set_t *queue_set, queue_t *queue_name)
+{
+    // 队列集合只在本进程中有效, 不能包含进程间共享队列
+    if ((!queue_set) || (!queue_name) || (queue_set->queue_num >= QUEUE_SET_MAX_SIZE) ||
+        (queue_name->flags & QUEUE_FLAG_SHARED))
+    {
+        return false;
+    }
 
-        // 数据插入队列
-        queue_name->data[queue_name->tail] = data[put_num];
+    queue_lock(queue_name);
 
-        // 修改队尾指针
-        queue_name->tail = ((queue_name->tail + 1) % queue_name->total_size);
+    if (queue_name->set)
+    {
+        pthread_mutex_unlock(&queue_name->queue_mutex);
 
-        // 元素个数增加
-        queue_name->current_size++;
+        return false;
     }
 
-    pthread_cond_signal(&queue_name->queue_cond);
+    queue_name->set = queue_set;
+    queue_set->queues[queue_set->queue_num++] = queue_name;
 
     pthread_mutex_unlock(&queue_name->queue_mutex);
 
-    return put_num;
+    // 添加前已有数据的队列不会再触发唤醒, 唤醒等待的线程重新检查
+    __atomic_add_fetch(&queue_set->seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&queue_set->waiters, __ATOMIC_SEQ_CST) > 0)
+    {
+        queue_sys_futex_wake(&queue_set->seq, INT_MAX);
+    }
+
+    return true;
 }
 
 /**
- * @brief  阻塞方式从循环队列中获取数据
+ * @brief  从队列集合中移除队列(不能与queue_set_wait()并发调用, 销毁队列前需先移除)
+ * @param  queue_set : 输出参数, 队列集合
  * @param  queue_name: 输出参数, 队列名
- * @param  data      : 输出参数, 获取到的数据
- * @param  data_len  : 输入参数, 指定获取长度
- * @return 成功: 实际获取个数
- *         失败: -1
+ * @return true : 成功
+ * @return false: 失败(参数错误或队列不属于该集合)
  */
-int queue_get_data(queue_t *queue_name, uint8_t *data, const uint32_t data_len)
+bool queue_set_remove(queue_set_t *queue_set, queue_t *queue_name)
 {
-    // 实际获取个数
-    uint32_t get_num = 0;
-
-    if ((!queue_name) || (!data) || (!data_len))
+    if ((!queue_set) || (!queue_name))
     {
-        return -1;
+        return false;
     }
 
-    // 没有数据才超时等待信号
-    // 使用while而不使用if, 防止该线程进入睡眠时, 被其他信号打断, 而过早的退出睡眠
-    while (0 == queue_get_current_size(*queue_name))
-    {
-        pthread_mutex_lock(&queue_name->queue_mutex);
-
-        pthread_cond_wait(&queue_name->queue_cond, &queue_name->queue_mutex);
+    queue_lock(queue_name);
 
+    if (queue_set != queue_name->set)
+    {
         pthread_mutex_unlock(&queue_name->queue_mutex);
+
+        return false;
     }
 
-    pthread_mutex_lock(&queue_name->queue_mutex);
+    queue_name->set = NULL;
+    queue_name->futex_wake_set = false;
+
+    pthread_mutex_unlock(&queue_name->queue_mutex);
 
-    for (get_num = 0; get_num < data_len; get_num++)
+    for (uint32_t i = 0; i < queue_set->queue_num; i++)
     {
-        // 队列为空, 直接退出
-        if (queue_name->head == queue_name->tail)
+        if (queue_set->queues[i] == queue_name)
         {
-            pthread_mutex_unlock(&queue_name->queue_mutex);
+            queue_set->queue_num--;
+            memmove(&queue_set->queues[i], &queue_set->queues[i + 1],
+                    ((queue_set->queue_num - i) * sizeof(queue_t *)));
 
-            return get_num;
+            break;
         }
+    }
+
+    return true;
+}
 
-        // 取队列头数据
-        data[get_num] = queue_name->data[queue_name->head];
+/**
+ * @brief  阻塞方式等待队列集合中任意一个队列非空
+ * @param  queue_set: 输出参数, 队列集合
+ * @param  ready    : 输出参数, 非空的队列
+ * @param  ready_num: 输入参数, ready数组大小
+ * @return 成功: 非空的队列个数
+ *         失败: -1
+ */
+int queue_set_wait(queue_set_t *queue_set, queue_t **ready, const uint32_t ready_num)
+{
+    if ((!queue_set) || (!ready) || (!ready_num))
+    {
+        return -1;
+    }
 
-        // 修改队头指针
-        queue_name->head = ((queue_name->head + 1) % queue_name->total_size);
+    return queue_set_wait_ready(queue_set, ready, ready_num, NULL);
+}
 
-        // 元素个数减小
-        queue_name->current_size--;
+/**
+ * @brief  超时方式等待队列集合中任意一个队列非空(超时时间为0, 直接检查各个队列)
+ * @param  queue_set: 输出参数, 队列集合
+ * @param  ready    : 输出参数, 非空的队列
+ * @param  ready_num: 输入参数, ready数组大小
+ * @param  timeout  : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 非空的队列个数(超时时间为0且没有非空的队列时为0)
+ *         失败: -1(参数错误或超时)
+ */
+int queue_set_wait_with_timeout(queue_set_t *queue_set, queue_t **ready, const uint32_t ready_num,
+                                const uint32_t timeout)
+{
+    if ((!queue_set) || (!ready) || (!ready_num))
+    {
+        return -1;
     }
 
-    pthread_mutex_unlock(&queue_name->queue_mutex);
+    if (0 == timeout)
+    {
+        return queue_set_get_ready(queue_set, ready, ready_num);
+    }
 
-    return get_num;
+    // 等待信号的结束时间
+    struct timespec end_time = {0};
+    queue_sys_deadline_after_ms(&end_time, timeout);
+
+    return queue_set_wait_ready(queue_set, ready, ready_num, &end_time);
 }
 
 /**
- * @brief  超时方式从循环队列中获取数据(超时时间为0, 直接从队列获取数据)
- * @param  queue_name: 输出参数, 队列名
- * @param  data      : 输出参数, 获取到的数据
- * @param  data_len  : 输入参数, 指定获取长度
- * @param  timeout   : 输入参数, 超时时间(单位: ms)
- * @return 成功: 实际获取个数
- *         失败: -1
+ * @brief  销毁队列集合(集合中剩余的队列一并移除)
+ * @param  queue_set: 输出参数, 队列集合
+ * @return true : 成功
+ * @return false: 失败
  */
-int queue_get_data_with_timeout(queue_t *queue_name, uint8_t *data, const uint32_t data_len, const uint32_t timeout)
+bool queue_set_destroy(queue_set_t *queue_set)
 {
-    // 实际获取个数
-    uint32_t get_num = 0;
+    if (!queue_set)
+    {
+        return false;
+    }
 
-    if ((!queue_name) || (!data) || (!data_len))
+    while (queue_set->queue_num > 0)
     {
-        return -1;
+        queue_set_remove(queue_set, queue_set->queues[queue_set->queue_num - 1]);
     }
 
-    if (timeout > 0)
+    memset(queue_set, 0, sizeof(queue_set_t));
+
+    return true;
+}
+
+/**
+ * @brief  设置唤醒阈值
+ *         默认只在有消费者等待且队列由空变为非空时唤醒, 设置阈值后, 队列数据量跨过阈值时额外唤醒一个消费者
+ * @param  queue_name: 输出参数, 队列名
+ * @param  threshold : 输入参数, 唤醒阈值(0表示不启用)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_set_signal_threshold(queue_t *queue_name, const uint32_t threshold)
+{
+    if (!queue_name)
     {
-        // 等待信号的开始时间
-        struct timespec start_time = {0};
-        clock_gettime(CLOCK_REALTIME, &start_time);
+        return false;
+    }
 
-        // 等待信号的结束时间
-        struct timespec end_time = {0};
-        end_time.tv_sec = (start_time.tv_sec + (timeout / 1000));
-        end_time.tv_nsec = ((start_time.tv_nsec + ((timeout % 1000) * 1000000)));
+    queue_lock(queue_name);
 
-        // tv_nsec必须小于1S
-        if (end_time.tv_nsec >= 1000000000)
-        {
-            end_time.tv_sec++;
-            end_time.tv_nsec -= 1000000000;
-        }
+    queue_name->signal_threshold = threshold;
 
-        // 没有数据才超时等待信号
-        // 使用while而不使用if, 防止该线程进入睡眠时, 被其他信号打断, 而过早的退出睡眠
-        while (0 == queue_get_current_size(*queue_name))
-        {
-            pthread_mutex_lock(&queue_name->queue_mutex);
+    pthread_mutex_unlock(&queue_name->queue_mutex);
 
-            // 超时方式等待一个信号
-            int ret = pthread_cond_timedwait(&queue_name->queue_cond, &queue_name->queue_mutex, &end_time);
-            // 超时, 直接返回
-            if (ETIMEDOUT == ret)
-            {
-                pthread_mutex_unlock(&queue_name->queue_mutex);
+    return true;
+}
 
-                return -1;
-            }
+/**
+ * @brief  获取省略的唤醒次数(没有等待者或无需唤醒时不调用pthread_cond_signal)
+ * @param  queue_name: 输入参数, 队列名
+ * @return 省略的唤醒次数
+ */
+uint64_t queue_get_skipped_signals(queue_t *queue_name)
+{
+    uint64_t skipped_signals = 0;
 
-            pthread_mutex_unlock(&queue_name->queue_mutex);
-        }
+    if (!queue_name)
+    {
+        return 0;
     }
 
-    pthread_mutex_lock(&queue_name->queue_mutex);
+    queue_lock(queue_name);
+
+    skipped_signals = queue_name->skipped_signals;
+
+    pthread_mutex_unlock(&queue_name->queue_mutex);
+
+    return skipped_signals;
+}
+
+/**
+ * @brief  获取因队列溢出丢弃的字节数(包括未写入的新数据和被覆盖的旧数据)
+ * @param  queue_name: 输入参数, 队列名
+ * @return 丢弃的字节数
+ */
+uint64_t queue_get_dropped_bytes(queue_t *queue_name)
+{
+    uint64_t dropped_bytes = 0;
 
-    for (get_num = 0; get_num < data_len; get_num++)
+    if (!queue_name)
     {
-        // 队列为空, 直接退出
-        if (queue_name->head == queue_name->tail)
-        {
-            pthread_mutex_unlock(&queue_name->queue_mutex);
+        return 0;
+    }
 
-            return get_num;
-        }
+    queue_lock(queue_name);
+
+    dropped_bytes = queue_name->dropped_bytes;
 
-        // 取队列头数据
-        data[get_num] = queue_name->data[queue_name->head];
+    pthread_mutex_unlock(&queue_name->queue_mutex);
 
-        // 修改队头指针
-        queue_name->head = ((queue_name->head + 1) % queue_name->total_size);
+    return dropped_bytes;
+}
 
-        // 元素个数减小
-        queue_name->current_size--;
+/**
+ * @brief  获取消费者等待统计
+ * @param  queue_name: 输入参数, 队列名
+ * @param  stats     : 输出参数, 消费者等待统计
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_get_wait_stats(queue_t *queue_name, queue_wait_stats_t *stats)
+{
+    if ((!queue_name) || (!stats))
+    {
+        return false;
     }
 
+    queue_lock(queue_name);
+
+    *stats = queue_name->wait_stats;
+
     pthread_mutex_unlock(&queue_name->queue_mutex);
 
-    return get_num;
+    return true;
 }
 
 /**
@@ -287,11 +3583,11 @@ int queue_get_data_with_timeout(queue_t *queue_name, uint8_t *data, const uint32
  */
 bool queue_is_empty(const queue_t queue_name)
 {
-    return ((!queue_name.current_size) ? true : false);
+    return ((!queue_get_used_size(&queue_name)) ? true : false);
 }
 
 /**
- * @brief  销毁队列
+ * @brief  销毁队列(进程间共享队列和持久化队列调用对应的关闭接口释放)
  * @param  queue_name: 输出参数, 队列名
  * @return true : 成功
  * @return false: 失败
@@ -300,12 +3596,15 @@ bool queue_destroy(queue_t *queue_name)
 {
     int ret = -1;
 
-    if (!queue_name)
+    // 进程间共享队列由queue_close_shared()和queue_unlink_shared()释放, 持久化队列由queue_close_persistent()释放
+    if ((!queue_name) || (queue_name->flags & (QUEUE_FLAG_SHARED | QUEUE_FLAG_PERSIST)))
     {
         return false;
     }
 
-    free(queue_name->data);
+    queue_free_buffer(queue_name);
+
+    queue_close_events(queue_name);
 
     ret = pthread_mutex_destroy(&queue_name->queue_mutex);
     if (0 != ret)
@@ -319,11 +3618,27 @@ bool queue_destroy(queue_t *queue_name)
         return false;
     }
 
+    ret = pthread_cond_destroy(&queue_name->not_full_cond);
+    if (0 != ret)
+    {
+        return false;
+    }
+
+    ret = pthread_cond_destroy(&queue_name->range_cond);
+    if (0 != ret)
+    {
+        return false;
+    }
+
     queue_name->head = queue_name->tail = 0;
 
     queue_name->current_size = 0;
 
     queue_name->total_size = 0;
 
+    queue_name->mask = 0;
+
+    queue_name->flags = 0;
+
     return true;
 }
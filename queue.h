@@ -21,20 +21,154 @@ extern "C"
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <time.h>
 #include <pthread.h>
 
+// queue_t结构体版本, 结构体布局或大小改变时递增
+// 版本不同时, 嵌入queue_t的预编译目标文件需重新编译, 不同版本的进程不能共享同一个队列
+#define QUEUE_ABI_VERSION 2
+
+// 队列模式标志
+#define QUEUE_FLAG_POW2 (1U << 0)    // 2的幂容量模式, 头尾指针自由递增, 掩码取下标
+#define QUEUE_FLAG_FUTEX (1U << 1)   // futex等待模式, 消费者直接在序号上等待, 不使用条件变量
+#define QUEUE_FLAG_MIRROR (1U << 2)  // 镜像映射模式, 缓冲区连续映射两次, 任意读写都是一段连续内存
+#define QUEUE_FLAG_MSG (1U << 3)     // 消息模式, 以带长度头的完整消息为单位读写, 不能使用字节流接口
+#define QUEUE_FLAG_GET_FD (1U << 4)  // 创建可读事件fd, 队列非空时可读, 用于epoll等事件循环
+#define QUEUE_FLAG_PUT_FD (1U << 5)  // 创建可写事件fd, 空闲空间满足写入时可读, 用于epoll等事件循环
+#define QUEUE_FLAG_SHARED (1U << 6)  // 进程间共享队列, 由queue_init_shared()设置, 不能手动指定
+#define QUEUE_FLAG_PERSIST (1U << 7) // 持久化队列, 由queue_init_persistent()设置, 不能手动指定
+
+// 消费者等待策略
+typedef enum
+{
+    QUEUE_WAIT_BLOCK = 0,           // 直接休眠等待
+    QUEUE_WAIT_SPIN_THEN_BLOCK = 1, // 自旋指定次数后休眠等待
+    QUEUE_WAIT_ADAPTIVE = 2,        // 根据最近的数据到达间隔自适应自旋, 间隔较长时直接休眠
+    QUEUE_WAIT_BUSY_POLL = 3,       // 一直自旋等待, 不休眠(适用于独占CPU的消费者)
+} queue_wait_policy_t;
+
+// 队列溢出策略(不等待的写入接口空间不足时的处理方式)
+typedef enum
+{
+    QUEUE_OVERFLOW_TRUNCATE = 0,  // 只写入能放下的部分(默认)
+    QUEUE_OVERFLOW_REJECT = 1,    // 不写入任何数据
+    QUEUE_OVERFLOW_OVERWRITE = 2, // 丢弃最旧的数据, 保留最新的数据(新数据超过队列容量时只保留最后的部分)
+} queue_overflow_policy_t;
+
+// 持久化队列同步策略
+typedef enum
+{
+    QUEUE_SYNC_NONE = 0,     // 不主动同步, 由内核回写(进程崩溃不丢数据, 系统掉电可能丢失最近的数据)
+    QUEUE_SYNC_PERIODIC = 1, // 距上次同步超过同步间隔时, 读写后同步到文件
+    QUEUE_SYNC_COMMIT = 2,   // 每次读写后同步到文件
+} queue_sync_policy_t;
+
+#define QUEUE_DEFAULT_SPIN_COUNT 1000   // 默认自旋次数
+#define QUEUE_DEFAULT_MAX_SPIN_NS 50000 // 自适应策略默认最大自旋时间(单位: ns)
+#define QUEUE_DEFAULT_SYNC_INTERVAL 100 // 持久化队列默认同步间隔(单位: ms)
+#define QUEUE_DEFAULT_SHRINK_DELAY 1000 // 自动调整容量的队列默认缩容延迟(单位: ms)
+
+// 队列属性结构体
+typedef struct
+{
+    uint32_t flags;                          // 队列模式标志(QUEUE_FLAG_xxx组合)
+    queue_wait_policy_t wait_policy;         // 消费者等待策略
+    uint32_t spin_count;                     // 自旋次数(QUEUE_WAIT_SPIN_THEN_BLOCK策略使用)
+    uint32_t max_spin_ns;                    // 最大自旋时间(QUEUE_WAIT_ADAPTIVE策略使用, 单位: ns)
+    uint32_t element_size;                   // 元素大小(0表示字节流队列, 非0时队列容量以元素个数计算)
+    queue_sync_policy_t sync_policy;         // 持久化队列同步策略
+    uint32_t sync_interval;                  // 持久化队列同步间隔(QUEUE_SYNC_PERIODIC策略使用, 单位: ms)
+    queue_overflow_policy_t overflow_policy; // 队列溢出策略
+    uint32_t max_size;                       // 自动扩容的最大容量(与queue_size单位相同, 0表示不自动调整容量, 只用于queue_init_with_attr())
+    uint32_t shrink_delay;                   // 自动缩容延迟, 占用率持续低于1/4超过该时间后容量减半(单位: ms, 0表示只扩容不缩容)
+} queue_attr_t;
+
+// 消费者等待统计
+typedef struct
+{
+    uint64_t spin_hits;   // 自旋期间等到数据的次数
+    uint64_t spin_misses; // 自旋结束仍没有数据的次数
+    uint64_t blocks;      // 休眠等待的次数
+    uint32_t avg_wait_ns; // 最近的平均等待时间(QUEUE_WAIT_ADAPTIVE策略统计, 单位: ns)
+} queue_wait_stats_t;
+
+// 缓冲区片段(零拷贝接口使用)
+typedef struct
+{
+    uint8_t *data; // 片段起始地址
+    uint32_t len;  // 片段长度
+} queue_segment_t;
+
+// 消息缓冲区(批量获取消息使用)
+typedef struct
+{
+    uint8_t *data; // 消息缓冲区
+    uint32_t size; // 消息缓冲区大小
+    uint32_t len;  // 获取到的消息长度
+} queue_msg_t;
+
+struct queue_set;
+
 // 循环队列结构体
 typedef struct
 {
-    uint8_t *data;               // 指向缓冲区的指针
-    uint32_t head;               // 队列头指针(指向队列头元素)
-    uint32_t tail;               // 队列尾指针(指向队列尾元素的下一个位置)
-    uint32_t total_size;         // 队列缓冲区的总大小
-    uint32_t current_size;       // 队列当前大小
-    pthread_mutex_t queue_mutex; // 队列互斥锁
-    pthread_cond_t queue_cond;   // 队列条件变量
+    uint8_t *data;                           // 指向缓冲区的指针
+    uint32_t head;                           // 队列头指针(指向队列头元素, 2的幂模式下为自由递增的计数)
+    uint32_t tail;                           // 队列尾指针(指向队列尾元素的下一个位置, 2的幂模式下为自由递增的计数)
+    uint32_t total_size;                     // 队列缓冲区的总大小
+    uint32_t current_size;                   // 队列当前大小(2的幂模式下不维护, 由tail - head推导)
+    pthread_mutex_t queue_mutex;             // 队列互斥锁
+    pthread_cond_t queue_cond;               // 队列条件变量(队列非空)
+    uint32_t mask;                           // 2的幂模式下标掩码(total_size - 1)
+    uint32_t flags;                          // 队列模式标志
+    pthread_cond_t not_full_cond;            // 队列条件变量(队列未满)
+    pthread_cond_t range_cond;               // 队列条件变量(数据量达到等待的最小长度)
+    uint32_t get_waiters;                    // 等待数据的消费者个数
+    uint32_t put_waiters;                    // 等待空间的生产者个数
+    uint32_t put_wait_need;                  // 等待的生产者需要的最大空闲空间(0表示只需1字节)
+    uint32_t signal_threshold;               // 唤醒阈值, 队列数据量跨过该值时额外唤醒一个消费者(0表示不启用)
+    uint64_t skipped_signals;                // 存在等待者但省略的唤醒次数
+    queue_overflow_policy_t overflow_policy; // 队列溢出策略
+    uint64_t dropped_bytes;                  // 因队列溢出丢弃的字节数
+    uint32_t futex_seq;                      // futex等待模式下的唤醒序号, 消费者在该地址上等待
+    bool futex_wake;                         // futex等待模式下, 解锁后是否需要唤醒消费者
+    uint32_t range_waiters;                  // 等待最小长度的消费者个数
+    uint32_t get_wait_need;                  // 等待的消费者需要的最小长度中的最小值(0表示没有登记)
+    uint32_t range_seq;                      // futex等待模式下等待最小长度的消费者的唤醒序号
+    bool futex_wake_range;                   // futex等待模式下, 解锁后是否需要唤醒全部等待最小长度的消费者
+    queue_wait_policy_t wait_policy;         // 消费者等待策略
+    uint32_t spin_count;                     // 自旋次数
+    uint32_t max_spin_ns;                    // 最大自旋时间(单位: ns)
+    queue_wait_stats_t wait_stats;           // 消费者等待统计
+    uint32_t put_reserved;                   // 生产者预留但还未提交的长度
+    uint32_t get_viewed;                     // 消费者视图中还未释放的长度
+    uint32_t element_size;                   // 元素大小(0表示字节流队列)
+    int get_event_fd;                        // 可读事件fd(-1表示未启用)
+    int put_event_fd;                        // 可写事件fd(-1表示未启用)
+    bool get_event_set;                      // 可读事件fd是否已置位
+    bool put_event_set;                      // 可写事件fd是否已置位
+    struct queue_set *set;                   // 所属的队列集合(NULL表示不属于任何集合)
+    bool futex_wake_set;                     // 解锁后是否需要唤醒等待队列集合的线程
+    uint32_t put_event_need;                 // 可写事件fd置位需要的空闲空间(上次整体写入失败时的长度, 0表示只需一个最小单位)
+    uint32_t min_size;                       // 自动缩容的最小容量(初始化时的容量)
+    uint32_t max_size;                       // 自动扩容的最大容量(0表示不自动调整容量)
+    uint32_t shrink_delay;                   // 自动缩容延迟(单位: ms)
+    uint64_t low_since_ns;                   // 占用率开始低于1/4的时间(CLOCK_MONOTONIC时钟, 0表示占用率不低)
 } queue_t;
 
+#define QUEUE_SET_MAX_SIZE 64 // 队列集合最多包含的队列个数
+
+// 队列集合结构体
+// 成员队列由空变为非空时递增唤醒序号, 等待的线程在唤醒序号上休眠, 被唤醒后检查各个队列
+typedef struct queue_set
+{
+    queue_t *queues[QUEUE_SET_MAX_SIZE]; // 集合中的队列
+    uint32_t queue_num;                  // 集合中的队列个数
+    uint32_t start_index;                // 下次检查的起始位置(轮流优先, 避免后面的队列一直排在最后)
+    uint32_t seq;                        // 唤醒序号(futex等待地址)
+    uint32_t waiters;                    // 等待的线程个数
+} queue_set_t;
+
 /**
  * @brief  初始化循环队列
  * @param  queue_name: 输出参数, 队列名
@@ -44,6 +178,130 @@ typedef struct
  */
 bool queue_init(queue_t *queue_name, const uint32_t queue_size);
 
+/**
+ * @brief  以2的幂容量模式初始化循环队列
+ *         容量向上取整为2的幂, 缓冲区全部可用, 读写时使用掩码代替取模
+ * @param  queue_name: 输出参数, 队列名
+ * @param  queue_size: 输入参数, 队列最小容量(不能超过2^31)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_init_pow2(queue_t *queue_name, const uint32_t queue_size);
+
+/**
+ * @brief  初始化固定大小元素队列
+ *         读写以元素为单位, 缓冲区大小是元素大小的整数倍, 元素不会跨越缓冲区末尾
+ * @param  queue_name  : 输出参数, 队列名
+ * @param  element_size: 输入参数, 元素大小
+ * @param  queue_size  : 输入参数, 队列容量(元素个数)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_init_elem(queue_t *queue_name, const uint32_t element_size, const uint32_t queue_size);
+
+/**
+ * @brief  初始化队列属性为默认值
+ * @param  attr: 输出参数, 队列属性
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_attr_init(queue_attr_t *attr);
+
+/**
+ * @brief  按指定属性初始化循环队列
+ * @param  queue_name: 输出参数, 队列名
+ * @param  queue_size: 输入参数, 队列容量(2的幂模式下向上取整为2的幂, 不能超过2^31;
+ *                     镜像映射模式下缓冲区向上取整为页大小的整数倍, 实际容量可能大于指定值;
+ *                     指定元素大小时为元素个数, 2的幂模式下元素大小也必须是2的幂)
+ * @param  attr      : 输入参数, 队列属性
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_init_with_attr(queue_t *queue_name, const uint32_t queue_size, const queue_attr_t *attr);
+
+/**
+ * @brief  创建进程间共享队列(默认属性)
+ *         队列和缓冲区放在名为name的POSIX共享内存中, 其他进程调用queue_open_shared()打开后直接读写, 无需内核拷贝
+ * @param  name      : 输入参数, 共享内存名称(以'/'开头, 如"/my_queue", 已存在时失败)
+ * @param  queue_size: 输入参数, 队列缓冲区的总大小
+ * @return 成功: 队列指针(指向共享内存)
+ *         失败: NULL
+ */
+queue_t *queue_init_shared(const char *name, const uint32_t queue_size);
+
+/**
+ * @brief  按指定属性创建进程间共享队列
+ *         互斥锁和条件变量设置为进程间共享, 互斥锁为健壮锁, 持有锁的进程退出后其他进程仍可加锁
+ * @param  name      : 输入参数, 共享内存名称(以'/'开头, 如"/my_queue", 已存在时失败)
+ * @param  queue_size: 输入参数, 队列容量(2的幂模式下向上取整为2的幂, 不能超过2^31)
+ * @param  attr      : 输入参数, 队列属性(不支持QUEUE_FLAG_FUTEX, QUEUE_FLAG_MIRROR和事件fd)
+ * @return 成功: 队列指针(指向共享内存)
+ *         失败: NULL
+ */
+queue_t *queue_init_shared_with_attr(const char *name, const uint32_t queue_size, const queue_attr_t *attr);
+
+/**
+ * @brief  打开其他进程创建的进程间共享队列
+ * @param  name: 输入参数, 共享内存名称(与创建时一致)
+ * @return 成功: 队列指针(指向共享内存)
+ *         失败: NULL(不存在或还未初始化完成)
+ */
+queue_t *queue_open_shared(const char *name);
+
+/**
+ * @brief  关闭进程间共享队列(只解除本进程的映射, 其他进程仍可继续使用)
+ * @param  queue_name: 输入参数, 队列指针(queue_init_shared()或queue_open_shared()的返回值)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_close_shared(queue_t *queue_name);
+
+/**
+ * @brief  删除进程间共享队列的名称, 所有进程关闭后释放共享内存
+ * @param  name: 输入参数, 共享内存名称
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_unlink_shared(const char *name);
+
+/**
+ * @brief  打开持久化队列(默认属性), 文件不存在时创建
+ *         队列和缓冲区映射到文件, 进程重启后打开同一个文件即可恢复未读取的消息
+ * @param  path      : 输入参数, 文件路径
+ * @param  queue_size: 输入参数, 队列缓冲区的总大小(恢复已有文件时使用文件中的大小)
+ * @return 成功: 队列指针(指向文件映射)
+ *         失败: NULL
+ */
+queue_t *queue_init_persistent(const char *path, const uint32_t queue_size);
+
+/**
+ * @brief  按指定属性打开持久化队列, 文件不存在时创建
+ *         持久化队列为消息模式, 每条消息带校验和; 恢复时只校验队列信息, 不读取缓冲区, 耗时与数据量无关
+ *         队列读取后头指针不一定立即写入文件, 系统掉电时可能重复读取最近的消息
+ * @param  path      : 输入参数, 文件路径(同一时刻只能被一个队列打开)
+ * @param  queue_size: 输入参数, 队列容量(恢复已有文件时使用文件中的容量和属性)
+ * @param  attr      : 输入参数, 队列属性(sync_policy指定同步策略, 不支持QUEUE_FLAG_FUTEX, QUEUE_FLAG_MIRROR和固定大小元素)
+ * @return 成功: 队列指针(指向文件映射)
+ *         失败: NULL(参数错误, 文件已被打开或文件中的队列信息不一致)
+ */
+queue_t *queue_init_persistent_with_attr(const char *path, const uint32_t queue_size, const queue_attr_t *attr);
+
+/**
+ * @brief  立即将持久化队列同步到文件
+ * @param  queue_name: 输入参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_sync_persistent(queue_t *queue_name);
+
+/**
+ * @brief  关闭持久化队列, 关闭前同步到文件, 未读取的消息保留在文件中
+ * @param  queue_name: 输入参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_close_persistent(queue_t *queue_name);
+
 /**
  * @brief  清空队列
  * @param  queue_name: 输出参数, 队列名
@@ -52,23 +310,122 @@ bool queue_init(queue_t *queue_name, const uint32_t queue_size);
  */
 bool queue_clear(queue_t *queue_name);
 
+/**
+ * @brief  调整队列容量, 在一次加锁中重新分配缓冲区, 并把已有数据按顺序拷贝到新缓冲区开头
+ *         等待中的生产者和消费者不受影响, 扩容后唤醒等待空间的生产者
+ * @param  queue_name: 输出参数, 队列名
+ * @param  queue_size: 输入参数, 新的队列容量(与初始化时单位相同, 2的幂模式下向上取整为2的幂)
+ * @return true : 成功
+ * @return false: 失败(进程间共享队列和持久化队列, 新容量放不下已有数据, 有未提交的预留或未释放的视图, 或内存不足)
+ */
+bool queue_resize(queue_t *queue_name, const uint32_t queue_size);
+
 /**
  * @brief  获取队列当前元素个数
  * @param  queue_name: 输入参数, 队列名
- * @return 队列当前元素个数
+ * @return 队列当前元素个数(固定大小元素队列为元素个数, 其他队列为字节数)
  */
 uint32_t queue_get_current_size(queue_t queue_name);
 
 /**
- * @brief  写入数据到循环队列
+ * @brief  写入数据到循环队列, 空间不足时按队列的溢出策略处理
  * @param  queue_name: 输出参数, 队列名
  * @param  data      : 输入参数, 待插入数据
  * @param  data_len  : 输入参数, 待插入数据长度
- * @return 成功: 实际插入个数
+ * @return 成功: 实际插入个数(覆盖最旧数据策略下为data_len, 拒绝写入策略下空间不足时为0)
  *         失败: -1
  */
 int queue_put_data(queue_t *queue_name, const uint8_t *data, const uint32_t data_len);
 
+/**
+ * @brief  阻塞方式写入数据到循环队列(队列满时等待消费者释放空间, 直到全部写入)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return 成功: 实际插入个数
+ *         失败: -1
+ */
+int queue_put_data_blocking(queue_t *queue_name, const uint8_t *data, const uint32_t data_len);
+
+/**
+ * @brief  超时方式写入数据到循环队列(超时时间为0, 直接写入队列)
+ *         队列满时等待消费者释放空间, 直到全部写入或超时
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际插入个数
+ *         失败: -1(超时且未写入任何数据)
+ */
+int queue_put_data_with_timeout(queue_t *queue_name, const uint8_t *data, const uint32_t data_len,
+                                const uint32_t timeout);
+
+/**
+ * @brief  整体写入数据到循环队列(空闲空间不足时不写入任何数据)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return 成功: 插入个数(等于待插入数据长度, 空闲空间不足时为0)
+ *         失败: -1(参数错误或数据长度超过队列容量)
+ */
+int queue_put_data_all(queue_t *queue_name, const uint8_t *data, const uint32_t data_len);
+
+/**
+ * @brief  阻塞方式整体写入数据到循环队列(空闲空间不足时等待, 直到可以一次全部写入)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return 成功: 插入个数(等于待插入数据长度)
+ *         失败: -1(参数错误或数据长度超过队列容量)
+ */
+int queue_put_data_all_blocking(queue_t *queue_name, const uint8_t *data, const uint32_t data_len);
+
+/**
+ * @brief  超时方式整体写入数据到循环队列(超时时间为0, 直接写入队列)
+ *         空闲空间不足时等待, 直到可以一次全部写入或超时, 超时时不写入任何数据
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 插入个数(等于待插入数据长度, 超时时间为0且空闲空间不足时为0)
+ *         失败: -1(参数错误, 数据长度超过队列容量或超时)
+ */
+int queue_put_data_all_with_timeout(queue_t *queue_name, const uint8_t *data, const uint32_t data_len,
+                                    const uint32_t timeout);
+
+/**
+ * @brief  预留队列空闲空间, 生产者直接向返回的片段写入数据, 再调用queue_put_commit()发布
+ *         同一时刻只能有一个未提交的预留, 预留期间其他写入操作视为队列已满
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data_len  : 输入参数, 需要预留的长度
+ * @param  seg1      : 输出参数, 第一段可写空间
+ * @param  seg2      : 输出参数, 第二段可写空间(空间不回绕或镜像映射模式下长度为0)
+ * @return 成功: 实际预留长度(队列已满时为0)
+ *         失败: -1(参数错误或已有未提交的预留)
+ */
+int queue_put_reserve(queue_t *queue_name, const uint32_t data_len, queue_segment_t *seg1, queue_segment_t *seg2);
+
+/**
+ * @brief  提交预留空间中已写入的数据(提交长度可小于预留长度, 为0时取消预留)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data_len  : 输入参数, 提交长度
+ * @return 成功: 实际提交长度
+ *         失败: -1(参数错误或提交长度超过预留长度)
+ */
+int queue_put_commit(queue_t *queue_name, const uint32_t data_len);
+
+/**
+ * @brief  写入一条完整消息到消息模式队列(超时时间为0, 直接写入队列)
+ *         消息和长度头一次写入, 空间不足时不写入任何数据
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 消息内容
+ * @param  data_len  : 输入参数, 消息长度
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 消息长度(超时时间为0且空间不足时为0)
+ *         失败: -1(参数错误, 消息超过队列容量或超时)
+ */
+int queue_put_msg(queue_t *queue_name, const uint8_t *data, const uint32_t data_len, const uint32_t timeout);
+
 /**
  * @brief  阻塞方式从循环队列中获取数据
  * @param  queue_name: 输出参数, 队列名
@@ -90,6 +447,240 @@ int queue_get_data(queue_t *queue_name, uint8_t *data, const uint32_t data_len);
  */
 int queue_get_data_with_timeout(queue_t *queue_name, uint8_t *data, const uint32_t data_len, const uint32_t timeout);
 
+/**
+ * @brief  按长度范围从循环队列中获取数据(超时时间为0, 直接获取)
+ *         等待队列中至少有min_len字节后, 最多拷贝max_len字节; 生产者只在数据量跨过等待的最小长度时唤醒
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  min_len   : 输入参数, 最小获取长度(不能超过队列容量)
+ * @param  max_len   : 输入参数, 最大获取长度(不能小于最小获取长度)
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际获取个数(超时时间为0且数据不足最小长度时为0)
+ *         失败: -1(参数错误或超时, 超时时不获取任何数据)
+ */
+int queue_get_data_range(queue_t *queue_name, uint8_t *data, const uint32_t min_len, const uint32_t max_len,
+                         const uint32_t timeout);
+
+/**
+ * @brief  计算超时结束时间(CLOCK_MONOTONIC时钟, 不受系统时间调整影响)
+ *         循环读取时计算一次, 之后多次调用xxx_until()接口复用同一个结束时间
+ * @param  deadline  : 输出参数, 超时结束时间
+ * @param  timeout_ns: 输入参数, 超时时间(单位: ns)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_deadline_after_ns(struct timespec *deadline, const uint64_t timeout_ns);
+
+/**
+ * @brief  指定结束时间从循环队列中获取数据(结束时间已过, 直接从队列获取数据)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @param  deadline  : 输入参数, 超时结束时间(CLOCK_MONOTONIC时钟, 为NULL时一直等待)
+ * @return 成功: 实际获取个数
+ *         失败: -1(参数错误或超时)
+ */
+int queue_get_data_until(queue_t *queue_name, uint8_t *data, const uint32_t data_len,
+                         const struct timespec *deadline);
+
+/**
+ * @brief  指定结束时间按长度范围从循环队列中获取数据
+ *         等待队列中至少有min_len字节后, 最多拷贝max_len字节
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  min_len   : 输入参数, 最小获取长度(不能超过队列容量)
+ * @param  max_len   : 输入参数, 最大获取长度(不能小于最小获取长度)
+ * @param  deadline  : 输入参数, 超时结束时间(CLOCK_MONOTONIC时钟, 为NULL时一直等待)
+ * @return 成功: 实际获取个数
+ *         失败: -1(参数错误或超时, 超时时不获取任何数据)
+ */
+int queue_get_data_range_until(queue_t *queue_name, uint8_t *data, const uint32_t min_len, const uint32_t max_len,
+                               const struct timespec *deadline);
+
+/**
+ * @brief  获取消费者视图, 返回指向队列数据的片段, 不移动队列头指针(超时时间为0, 直接获取)
+ *         处理完成后调用queue_get_release()释放, 同一时刻只能有一个未释放的视图, 视图未释放期间其他读取操作视为队列为空
+ * @param  queue_name: 输出参数, 队列名
+ * @param  seg1      : 输出参数, 第一段可读数据
+ * @param  seg2      : 输出参数, 第二段可读数据(数据不回绕或镜像映射模式下长度为0)
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 可读数据总长度(超时时间为0且队列为空时为0)
+ *         失败: -1(参数错误, 已有未释放的视图或超时)
+ */
+int queue_get_view(queue_t *queue_name, queue_segment_t *seg1, queue_segment_t *seg2, const uint32_t timeout);
+
+/**
+ * @brief  释放消费者视图中已处理的数据(释放长度可小于视图长度, 为0时只结束视图不消费数据)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data_len  : 输入参数, 释放长度
+ * @return 成功: 实际释放长度
+ *         失败: -1(参数错误或释放长度超过视图长度)
+ */
+int queue_get_release(queue_t *queue_name, const uint32_t data_len);
+
+/**
+ * @brief  写入元素到固定大小元素队列(超时时间为0, 直接写入队列, 空间不足时按队列的溢出策略处理)
+ *         队列满时等待消费者释放空间, 直到全部写入或超时
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入元素
+ * @param  elem_num  : 输入参数, 待插入元素个数
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际插入元素个数
+ *         失败: -1(参数错误或超时且未写入任何元素)
+ */
+int queue_put_elem(queue_t *queue_name, const void *data, const uint32_t elem_num, const uint32_t timeout);
+
+/**
+ * @brief  从固定大小元素队列中获取元素(超时时间为0, 直接获取)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的元素
+ * @param  elem_num  : 输入参数, 指定获取元素个数
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际获取元素个数(超时时间为0且队列为空时为0)
+ *         失败: -1(参数错误或超时)
+ */
+int queue_get_elem(queue_t *queue_name, void *data, const uint32_t elem_num, const uint32_t timeout);
+
+/**
+ * @brief  获取消息模式队列中下一条消息的长度(不消费消息)
+ * @param  queue_name: 输入参数, 队列名
+ * @return 成功: 下一条消息的长度(队列为空, 或持久化队列校验失败丢弃数据时为0)
+ *         失败: -1
+ */
+int queue_get_msg_size(queue_t *queue_name);
+
+/**
+ * @brief  从消息模式队列中获取一条完整消息(超时时间为0, 直接获取)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的消息
+ * @param  data_len  : 输入参数, 消息缓冲区大小
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 消息长度(超时时间为0且队列为空时为0)
+ *         失败: -1(参数错误, 超时或缓冲区不足, 缓冲区不足时消息保留在队列中)
+ */
+int queue_get_msg(queue_t *queue_name, uint8_t *data, const uint32_t data_len, const uint32_t timeout);
+
+/**
+ * @brief  从消息模式队列中批量获取消息, 只加锁一次(超时时间为0, 直接获取)
+ *         只等待第一条消息, 之后队列为空或消息超过对应缓冲区大小时停止
+ * @param  queue_name: 输出参数, 队列名
+ * @param  msgs      : 输出参数, 消息缓冲区数组, 获取到的消息长度保存在len中
+ * @param  msg_num   : 输入参数, 消息缓冲区个数
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 获取到的消息个数(超时时间为0且队列为空时为0)
+ *         失败: -1(参数错误, 超时或第一条消息超过缓冲区大小)
+ */
+int queue_get_msgs(queue_t *queue_name, queue_msg_t *msgs, const uint32_t msg_num, const uint32_t timeout);
+
+/**
+ * @brief  获取可读事件fd(初始化时需设置QUEUE_FLAG_GET_FD标志)
+ *         队列由空变为非空时置位, 被读空时清除, 可加入epoll/poll/select监听可读事件
+ *         事件fd由队列维护, 调用者不需要读取, 也不能关闭
+ * @param  queue_name: 输入参数, 队列名
+ * @return 成功: 可读事件fd
+ *         失败: -1(参数错误或未启用)
+ */
+int queue_get_fd(queue_t *queue_name);
+
+/**
+ * @brief  获取可写事件fd(初始化时需设置QUEUE_FLAG_PUT_FD标志)
+ *         空闲空间不足时清除, 空闲空间满足上次失败的写入时置位, 可加入epoll/poll/select监听可读事件
+ *         事件fd由队列维护, 调用者不需要读取, 也不能关闭
+ * @param  queue_name: 输入参数, 队列名
+ * @return 成功: 可写事件fd
+ *         失败: -1(参数错误或未启用)
+ */
+int queue_get_put_fd(queue_t *queue_name);
+
+/**
+ * @brief  初始化队列集合
+ * @param  queue_set: 输出参数, 队列集合
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_set_init(queue_set_t *queue_set);
+
+/**
+ * @brief  添加队列到队列集合(一个队列只能属于一个集合, 不能与queue_set_wait()并发调用)
+ * @param  queue_set : 输出参数, 队列集合
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败(参数错误, 集合已满或队列已属于某个集合)
+ */
+bool queue_set_add(queue_set_t *queue_set, queue_t *queue_name);
+
+/**
+ * @brief  从队列集合中移除队列(不能与queue_set_wait()并发调用, 销毁队列前需先移除)
+ * @param  queue_set : 输出参数, 队列集合
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败(参数错误或队列不属于该集合)
+ */
+bool queue_set_remove(queue_set_t *queue_set, queue_t *queue_name);
+
+/**
+ * @brief  阻塞方式等待队列集合中任意一个队列非空
+ * @param  queue_set: 输出参数, 队列集合
+ * @param  ready    : 输出参数, 非空的队列
+ * @param  ready_num: 输入参数, ready数组大小
+ * @return 成功: 非空的队列个数
+ *         失败: -1
+ */
+int queue_set_wait(queue_set_t *queue_set, queue_t **ready, const uint32_t ready_num);
+
+/**
+ * @brief  超时方式等待队列集合中任意一个队列非空(超时时间为0, 直接检查各个队列)
+ * @param  queue_set: 输出参数, 队列集合
+ * @param  ready    : 输出参数, 非空的队列
+ * @param  ready_num: 输入参数, ready数组大小
+ * @param  timeout  : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 非空的队列个数(超时时间为0且没有非空的队列时为0)
+ *         失败: -1(参数错误或超时)
+ */
+int queue_set_wait_with_timeout(queue_set_t *queue_set, queue_t **ready, const uint32_t ready_num,
+                                const uint32_t timeout);
+
+/**
+ * @brief  销毁队列集合(集合中剩余的队列一并移除)
+ * @param  queue_set: 输出参数, 队列集合
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_set_destroy(queue_set_t *queue_set);
+
+/**
+ * @brief  设置唤醒阈值
+ *         默认只在有消费者等待且队列由空变为非空时唤醒, 设置阈值后, 队列数据量跨过阈值时额外唤醒一个消费者
+ * @param  queue_name: 输出参数, 队列名
+ * @param  threshold : 输入参数, 唤醒阈值(0表示不启用)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_set_signal_threshold(queue_t *queue_name, const uint32_t threshold);
+
+/**
+ * @brief  获取省略的唤醒次数(存在等待者, 但队列未由空变为非空(由满变为未满)或未跨过唤醒阈值, 因而没有唤醒的次数)
+ * @param  queue_name: 输入参数, 队列名
+ * @return 省略的唤醒次数
+ */
+uint64_t queue_get_skipped_signals(queue_t *queue_name);
+
+/**
+ * @brief  获取因队列溢出丢弃的字节数(包括未写入的新数据和被覆盖的旧数据)
+ * @param  queue_name: 输入参数, 队列名
+ * @return 丢弃的字节数
+ */
+uint64_t queue_get_dropped_bytes(queue_t *queue_name);
+
+/**
+ * @brief  获取消费者等待统计
+ * @param  queue_name: 输入参数, 队列名
+ * @param  stats     : 输出参数, 消费者等待统计
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool queue_get_wait_stats(queue_t *queue_name, queue_wait_stats_t *stats);
+
 /**
  * @brief  判断循环队列是否为空
  * @param  queue_name: 输入参数, 队列名
@@ -99,7 +690,7 @@ int queue_get_data_with_timeout(queue_t *queue_name, uint8_t *data, const uint32
 bool queue_is_empty(const queue_t queue_name);
 
 /**
- * @brief  销毁队列
+ * @brief  销毁队列(进程间共享队列和持久化队列调用对应的关闭接口释放)
  * @param  queue_name: 输出参数, 队列名
  * @return true : 成功
  * @return false: 失败
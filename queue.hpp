@@ -0,0 +1,956 @@
+/**
+ * @file      : queue.hpp
+ * @brief     : Linux平台队列驱动C++模板头文件(编译期确定容量、并发模式和等待策略的队列, 传递任意类型对象的通道)
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-16 16:00:00
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-16 huenrong        创建文件
+ *
+ */
+
+#ifndef __QUEUE_HPP
+#define __QUEUE_HPP
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "./queue_sys.h"
+
+#ifndef QUEUE_CACHE_LINE_SIZE
+#define QUEUE_CACHE_LINE_SIZE 64 // 缓存行大小
+#endif
+
+namespace linux_queue
+{
+
+// 生产者并发策略
+struct single_producer // 只有一个生产者线程, 写入位置无需原子竞争
+{
+};
+struct multi_producer // 多个生产者线程, 通过CAS抢占写入位置
+{
+};
+
+// 消费者并发策略
+struct single_consumer // 只有一个消费者线程, 读取位置无需原子竞争
+{
+};
+struct multi_consumer // 多个消费者线程, 通过CAS抢占读取位置
+{
+};
+
+// 消费者等待策略
+struct block_wait // 队列为空时直接休眠
+{
+};
+template <uint32_t SpinCount = 1000>
+struct spin_then_block_wait // 自旋指定次数后休眠(单核系统上直接休眠)
+{
+};
+struct busy_poll_wait // 一直自旋等待, 不休眠, 生产者也不检查休眠者(适用于独占CPU的消费者)
+{
+};
+
+namespace detail
+{
+
+/**
+ * @brief 消费者休眠等待和生产者唤醒(futex)
+ */
+class futex_waiter
+{
+public:
+    /**
+     * @brief  写入后唤醒休眠的消费者
+     * @param  wake_num: 输入参数, 最多唤醒的消费者个数
+     */
+    inline void wake(const uint32_t wake_num) noexcept
+    {
+        // 只有存在休眠的消费者时才修改唤醒序号并进入内核
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&waiters_, __ATOMIC_RELAXED) > 0)
+        {
+            __atomic_add_fetch(&put_seq_, 1, __ATOMIC_RELEASE);
+
+            queue_sys_futex_wake(&put_seq_, (int)((wake_num < INT_MAX) ? wake_num : INT_MAX));
+        }
+    }
+
+    /**
+     * @brief  休眠等待, 直到读取成功或超时
+     * @param  try_pop : 输入参数, 读取函数(成功返回true)
+     * @param  deadline: 输入参数, 超时结束时间(CLOCK_MONOTONIC时钟, 为nullptr时一直等待)
+     * @return true : 成功
+     * @return false: 超时
+     */
+    template <typename TryPop>
+    bool wait(TryPop &&try_pop, const struct timespec *deadline) noexcept
+    {
+        while (true)
+        {
+            if (try_pop())
+            {
+                return true;
+            }
+
+            // 先记录唤醒序号并登记为休眠者, 再检查一次队列
+            // 生产者写入后发现有休眠者会修改唤醒序号, futex因序号不一致立即返回, 不会丢失唤醒
+            uint32_t seq = __atomic_load_n(&put_seq_, __ATOMIC_ACQUIRE);
+            __atomic_add_fetch(&waiters_, 1, __ATOMIC_SEQ_CST);
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+            if (try_pop())
+            {
+                __atomic_sub_fetch(&waiters_, 1, __ATOMIC_RELAXED);
+
+                return true;
+            }
+
+            int ret = queue_sys_futex_wait(&put_seq_, seq, deadline);
+
+            __atomic_sub_fetch(&waiters_, 1, __ATOMIC_RELAXED);
+
+            // 超时, 最后再尝试读取一次
+            if (ETIMEDOUT == ret)
+            {
+                return try_pop();
+            }
+        }
+    }
+
+private:
+    uint32_t put_seq_ = 0; // 唤醒序号(futex等待地址)
+    uint32_t waiters_ = 0; // 休眠的消费者个数
+};
+
+} // namespace detail
+
+/**
+ * @brief 编译期确定容量、并发模式和等待策略的无锁队列
+ *        单生产者单消费者时使用头尾指针环形缓冲区, 其他组合使用带序号的槽位
+ *        容量为2的幂, 下标掩码为编译期常量, 快速路径全部内联
+ *        队列对象内含全部槽位, 容量较大时应在堆上创建
+ * @tparam T             : 元素类型(必须可平凡拷贝)
+ * @tparam Capacity      : 队列容量(元素个数, 必须是2的幂)
+ * @tparam ProducerPolicy: 生产者并发策略(single_producer或multi_producer)
+ * @tparam ConsumerPolicy: 消费者并发策略(single_consumer或multi_consumer)
+ * @tparam WaitPolicy    : 消费者等待策略(block_wait, spin_then_block_wait<N>或busy_poll_wait)
+ */
+template <typename T, uint32_t Capacity, typename ProducerPolicy = multi_producer,
+          typename ConsumerPolicy = multi_consumer, typename WaitPolicy = block_wait>
+class basic_queue
+{
+    static_assert(std::is_trivially_copyable<T>::value, "element type must be trivially copyable");
+    static_assert((Capacity > 0) && (Capacity <= (1U << 31)) && (0 == (Capacity & (Capacity - 1))),
+                  "capacity must be a power of two no larger than 2^31");
+    static_assert(std::is_same<ProducerPolicy, single_producer>::value ||
+                      std::is_same<ProducerPolicy, multi_producer>::value,
+                  "producer policy must be single_producer or multi_producer");
+    static_assert(std::is_same<ConsumerPolicy, single_consumer>::value ||
+                      std::is_same<ConsumerPolicy, multi_consumer>::value,
+                  "consumer policy must be single_consumer or multi_consumer");
+
+public:
+    static constexpr uint32_t capacity = Capacity;
+
+    basic_queue() noexcept
+    {
+        // 槽位序号初始化为下标, 表示第一轮写入可用
+        if constexpr (!is_spsc)
+        {
+            for (uint32_t i = 0; i < Capacity; i++)
+            {
+                slots_[i].seq = i;
+            }
+        }
+
+        if constexpr (is_spin_then_block<WaitPolicy>::value)
+        {
+            // 单核系统上自旋只会占用生产者的运行时间, 退化为直接休眠
+            spin_ = (sysconf(_SC_NPROCESSORS_ONLN) > 1);
+        }
+    }
+
+    basic_queue(const basic_queue &) = delete;
+    basic_queue &operator=(const basic_queue &) = delete;
+
+    /**
+     * @brief  写入一个元素(不阻塞)
+     * @param  value: 输入参数, 待插入元素
+     * @return true : 成功
+     * @return false: 队列已满
+     */
+    bool try_push(const T &value) noexcept
+    {
+        if (!push_one(value))
+        {
+            return false;
+        }
+
+        wake(1);
+
+        return true;
+    }
+
+    /**
+     * @brief  写入多个元素(不阻塞, 全部写入后只唤醒一次)
+     * @param  values: 输入参数, 待插入元素
+     * @param  num   : 输入参数, 待插入元素个数
+     * @return 实际插入元素个数
+     */
+    uint32_t try_push(const T *values, const uint32_t num) noexcept
+    {
+        uint32_t put_num = 0;
+
+        if constexpr (is_spsc)
+        {
+            // 单生产者单消费者时一次计算剩余空间, 最多分两段拷贝
+            uint32_t tail = tail_;
+            uint32_t free_size = (Capacity - (tail - cached_head_));
+            if (free_size < num)
+            {
+                cached_head_ = __atomic_load_n(&head_, __ATOMIC_ACQUIRE);
+                free_size = (Capacity - (tail - cached_head_));
+            }
+
+            put_num = ((free_size < num) ? free_size : num);
+            if (0 == put_num)
+            {
+                return 0;
+            }
+
+            uint32_t index = (tail & mask);
+            uint32_t first_num = (((Capacity - index) < put_num) ? (Capacity - index) : put_num);
+            std::memcpy(slots_[index].storage, values, (sizeof(T) * first_num));
+            if (put_num > first_num)
+            {
+                std::memcpy(slots_[0].storage, &values[first_num], (sizeof(T) * (put_num - first_num)));
+            }
+
+            __atomic_store_n(&tail_, (tail + put_num), __ATOMIC_RELEASE);
+        }
+        else
+        {
+            while ((put_num < num) && (push_one(values[put_num])))
+            {
+                put_num++;
+            }
+        }
+
+        if (put_num > 0)
+        {
+            wake(put_num);
+        }
+
+        return put_num;
+    }
+
+    /**
+     * @brief  读取一个元素(不阻塞)
+     * @param  value: 输出参数, 获取到的元素
+     * @return true : 成功
+     * @return false: 队列为空
+     */
+    bool try_pop(T &value) noexcept
+    {
+        return pop_one(value);
+    }
+
+    /**
+     * @brief  读取多个元素(不阻塞)
+     * @param  values: 输出参数, 获取到的元素
+     * @param  num   : 输入参数, 指定获取元素个数
+     * @return 实际获取元素个数
+     */
+    uint32_t try_pop(T *values, const uint32_t num) noexcept
+    {
+        uint32_t get_num = 0;
+
+        if constexpr (is_spsc)
+        {
+            // 单生产者单消费者时一次计算可读个数, 最多分两段拷贝
+            uint32_t head = head_;
+            uint32_t used_size = (cached_tail_ - head);
+            if (used_size < num)
+            {
+                cached_tail_ = __atomic_load_n(&tail_, __ATOMIC_ACQUIRE);
+                used_size = (cached_tail_ - head);
+            }
+
+            get_num = ((used_size < num) ? used_size : num);
+            if (0 == get_num)
+            {
+                return 0;
+            }
+
+            uint32_t index = (head & mask);
+            uint32_t first_num = (((Capacity - index) < get_num) ? (Capacity - index) : get_num);
+            std::memcpy(values, slots_[index].storage, (sizeof(T) * first_num));
+            if (get_num > first_num)
+            {
+                std::memcpy(&values[first_num], slots_[0].storage, (sizeof(T) * (get_num - first_num)));
+            }
+
+            __atomic_store_n(&head_, (head + get_num), __ATOMIC_RELEASE);
+        }
+        else
+        {
+            while ((get_num < num) && (pop_one(values[get_num])))
+            {
+                get_num++;
+            }
+        }
+
+        return get_num;
+    }
+
+    /**
+     * @brief  阻塞方式读取一个元素
+     * @param  value: 输出参数, 获取到的元素
+     * @return true : 成功
+     */
+    bool pop(T &value) noexcept
+    {
+        return pop_wait(value, nullptr);
+    }
+
+    /**
+     * @brief  超时方式读取一个元素(超时时间为0, 直接读取)
+     * @param  value  : 输出参数, 获取到的元素
+     * @param  timeout: 输入参数, 超时时间(单位: ms)
+     * @return true : 成功
+     * @return false: 超时
+     */
+    bool pop(T &value, const uint32_t timeout) noexcept
+    {
+        if (0 == timeout)
+        {
+            return pop_one(value);
+        }
+
+        // 等待信号的结束时间
+        struct timespec end_time = {0, 0};
+        queue_sys_deadline_after_ms(&end_time, timeout);
+
+        return pop_wait(value, &end_time);
+    }
+
+    /**
+     * @brief  获取队列当前元素个数(并发读写时为近似值)
+     * @return 队列当前元素个数
+     */
+    uint32_t size() const noexcept
+    {
+        uint32_t head = __atomic_load_n(&head_, __ATOMIC_ACQUIRE);
+        uint32_t tail = __atomic_load_n(&tail_, __ATOMIC_ACQUIRE);
+        uint32_t used_size = (tail - head);
+
+        // 多生产者多消费者时两次读取之间位置可能变化, 限制在容量范围内
+        return (((int32_t)used_size < 0) ? 0 : ((used_size > Capacity) ? Capacity : used_size));
+    }
+
+    /**
+     * @brief  判断队列是否为空
+     * @return true : 队列为空
+     * @return false: 队列非空
+     */
+    bool empty() const noexcept
+    {
+        return (0 == size());
+    }
+
+private:
+    template <typename W>
+    struct is_spin_then_block : std::false_type
+    {
+    };
+    template <uint32_t N>
+    struct is_spin_then_block<spin_then_block_wait<N>> : std::true_type
+    {
+        static constexpr uint32_t spin_count = N;
+    };
+
+    static constexpr uint32_t mask = (Capacity - 1);
+    static constexpr bool single_put = std::is_same<ProducerPolicy, single_producer>::value;
+    static constexpr bool single_get = std::is_same<ConsumerPolicy, single_consumer>::value;
+    static constexpr bool is_spsc = (single_put && single_get);
+    static constexpr bool busy_poll = std::is_same<WaitPolicy, busy_poll_wait>::value;
+
+    // 单生产者单消费者时只需存放元素, 其他组合每个槽位带一个序号
+    struct plain_slot
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    struct seq_slot
+    {
+        uint32_t seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    using slot_t = typename std::conditional<is_spsc, plain_slot, seq_slot>::type;
+
+    /**
+     * @brief  写入一个元素(不阻塞, 不唤醒消费者)
+     * @param  value: 输入参数, 待插入元素
+     * @return true : 成功
+     * @return false: 队列已满
+     */
+    inline bool push_one(const T &value) noexcept
+    {
+        if constexpr (is_spsc)
+        {
+            uint32_t tail = tail_;
+            if ((tail - cached_head_) == Capacity)
+            {
+                cached_head_ = __atomic_load_n(&head_, __ATOMIC_ACQUIRE);
+                if ((tail - cached_head_) == Capacity)
+                {
+                    return false;
+                }
+            }
+
+            std::memcpy(slots_[tail & mask].storage, &value, sizeof(T));
+            __atomic_store_n(&tail_, (tail + 1), __ATOMIC_RELEASE);
+
+            return true;
+        }
+        else
+        {
+            seq_slot *slot = nullptr;
+            uint32_t pos = __atomic_load_n(&tail_, __ATOMIC_RELAXED);
+
+            while (true)
+            {
+                slot = &slots_[pos & mask];
+                int32_t diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+
+                // 槽位中的元素还未被消费, 队列已满
+                if (diff < 0)
+                {
+                    return false;
+                }
+
+                if (0 == diff)
+                {
+                    // 单生产者时写入位置只由自己修改, 无需CAS
+                    if constexpr (single_put)
+                    {
+                        __atomic_store_n(&tail_, (pos + 1), __ATOMIC_RELAXED);
+
+                        break;
+                    }
+                    else if (__atomic_compare_exchange_n(&tail_, &pos, (pos + 1), true, __ATOMIC_RELAXED,
+                                                         __ATOMIC_RELAXED))
+                    {
+                        break;
+                    }
+                }
+                // 写入位置已被其他生产者抢占
+                else
+                {
+                    pos = __atomic_load_n(&tail_, __ATOMIC_RELAXED);
+                }
+            }
+
+            std::memcpy(slot->storage, &value, sizeof(T));
+
+            // 发布槽位, 序号等于pos + 1表示槽位中有数据
+            __atomic_store_n(&slot->seq, (pos + 1), __ATOMIC_RELEASE);
+
+            return true;
+        }
+    }
+
+    /**
+     * @brief  读取一个元素(不阻塞)
+     * @param  value: 输出参数, 获取到的元素
+     * @return true : 成功
+     * @return false: 队列为空
+     */
+    inline bool pop_one(T &value) noexcept
+    {
+        if constexpr (is_spsc)
+        {
+            uint32_t head = head_;
+            if (cached_tail_ == head)
+            {
+                cached_tail_ = __atomic_load_n(&tail_, __ATOMIC_ACQUIRE);
+                if (cached_tail_ == head)
+                {
+                    return false;
+                }
+            }
+
+            std::memcpy(&value, slots_[head & mask].storage, sizeof(T));
+            __atomic_store_n(&head_, (head + 1), __ATOMIC_RELEASE);
+
+            return true;
+        }
+        else
+        {
+            seq_slot *slot = nullptr;
+            uint32_t pos = __atomic_load_n(&head_, __ATOMIC_RELAXED);
+
+            while (true)
+            {
+                slot = &slots_[pos & mask];
+                int32_t diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - (pos + 1));
+
+                // 槽位还未写入, 队列为空
+                if (diff < 0)
+                {
+                    return false;
+                }
+
+                if (0 == diff)
+                {
+                    // 单消费者时读取位置只由自己修改, 无需CAS
+                    if constexpr (single_get)
+                    {
+                        __atomic_store_n(&head_, (pos + 1), __ATOMIC_RELAXED);
+
+                        break;
+                    }
+                    else if (__atomic_compare_exchange_n(&head_, &pos, (pos + 1), true, __ATOMIC_RELAXED,
+                                                         __ATOMIC_RELAXED))
+                    {
+                        break;
+                    }
+                }
+                // 读取位置已被其他消费者抢占
+                else
+                {
+                    pos = __atomic_load_n(&head_, __ATOMIC_RELAXED);
+                }
+            }
+
+            std::memcpy(&value, slot->storage, sizeof(T));
+
+            // 释放槽位, 序号前进一圈供下一轮生产者使用
+            __atomic_store_n(&slot->seq, (pos + Capacity), __ATOMIC_RELEASE);
+
+            return true;
+        }
+    }
+
+    /**
+     * @brief  写入后唤醒休眠的消费者(一直自旋策略下消费者不休眠, 编译期去掉)
+     * @param  put_num: 输入参数, 写入元素个数
+     */
+    inline void wake(const uint32_t put_num) noexcept
+    {
+        if constexpr (!busy_poll)
+        {
+            // 单消费者时最多只有一个休眠者
+            waiter_.wake(single_get ? 1 : put_num);
+        }
+        else
+        {
+            (void)put_num;
+        }
+    }
+
+    /**
+     * @brief  读取一个元素, 队列为空时按等待策略等待
+     * @param  value   : 输出参数, 获取到的元素
+     * @param  deadline: 输入参数, 超时结束时间(CLOCK_MONOTONIC时钟, 为nullptr时一直等待)
+     * @return true : 成功
+     * @return false: 超时
+     */
+    bool pop_wait(T &value, const struct timespec *deadline) noexcept
+    {
+        if constexpr (busy_poll)
+        {
+            uint64_t end_ns = (deadline ? queue_sys_timespec_to_ns(deadline) : 0);
+            while (!pop_one(value))
+            {
+                if ((deadline) && (queue_sys_get_time_ns(CLOCK_MONOTONIC) >= end_ns))
+                {
+                    return pop_one(value);
+                }
+
+                queue_sys_cpu_relax();
+            }
+
+            return true;
+        }
+        else
+        {
+            if constexpr (is_spin_then_block<WaitPolicy>::value)
+            {
+                for (uint32_t i = 0; (spin_) && (i < is_spin_then_block<WaitPolicy>::spin_count); i++)
+                {
+                    if (pop_one(value))
+                    {
+                        return true;
+                    }
+
+                    queue_sys_cpu_relax();
+                }
+            }
+
+            return waiter_.wait([&]() { return pop_one(value); }, deadline);
+        }
+    }
+
+    // 只读区
+    slot_t slots_[Capacity];
+    bool spin_ = false; // 是否自旋(spin_then_block_wait策略使用)
+
+    // 生产者区
+    alignas(QUEUE_CACHE_LINE_SIZE) uint32_t tail_ = 0; // 写入位置(自由递增)
+    uint32_t cached_head_ = 0;                         // 生产者缓存的读取位置(单生产者单消费者时使用)
+
+    // 消费者区
+    alignas(QUEUE_CACHE_LINE_SIZE) uint32_t head_ = 0; // 读取位置(自由递增)
+    uint32_t cached_tail_ = 0;                         // 消费者缓存的写入位置(单生产者单消费者时使用)
+
+    // 阻塞等待区
+    alignas(QUEUE_CACHE_LINE_SIZE) detail::futex_waiter waiter_;
+};
+
+// 常用组合
+template <typename T, uint32_t Capacity, typename WaitPolicy = block_wait>
+using spsc_queue = basic_queue<T, Capacity, single_producer, single_consumer, WaitPolicy>;
+
+template <typename T, uint32_t Capacity, typename WaitPolicy = block_wait>
+using mpsc_queue = basic_queue<T, Capacity, multi_producer, single_consumer, WaitPolicy>;
+
+template <typename T, uint32_t Capacity, typename WaitPolicy = block_wait>
+using mpmc_queue = basic_queue<T, Capacity, multi_producer, multi_consumer, WaitPolicy>;
+
+/**
+ * @brief 传递任意类型对象的多生产者多消费者通道
+ *        对象通过placement new直接构造在槽位中, 读取时移动给调用者, 线程间传递对象无需额外分配内存和序列化
+ *        容量在运行时指定(向上取整为2的幂), 槽位在构造时一次分配, 清空和析构时销毁剩余对象
+ * @tparam T: 元素类型(移动构造不能抛出异常)
+ */
+template <typename T>
+class channel
+{
+    static_assert(std::is_nothrow_move_constructible<T>::value, "element type must be nothrow move constructible");
+
+public:
+    /**
+     * @brief  构造通道
+     * @param  capacity: 输入参数, 通道最小容量(元素个数, 向上取整为2的幂, 不能超过2^31)
+     */
+    explicit channel(const uint32_t capacity)
+    {
+        if ((0 == capacity) || (capacity > (1U << 31)))
+        {
+            throw std::length_error("channel capacity must be in [1, 2^31]");
+        }
+
+        capacity_ = 1;
+        while (capacity_ < capacity)
+        {
+            capacity_ <<= 1;
+        }
+        mask_ = (capacity_ - 1);
+
+        // 槽位序号初始化为下标, 表示第一轮写入可用
+        slots_ = new slot_t[capacity_];
+        for (uint32_t i = 0; i < capacity_; i++)
+        {
+            slots_[i].seq = i;
+        }
+    }
+
+    ~channel()
+    {
+        clear();
+
+        delete[] slots_;
+    }
+
+    channel(const channel &) = delete;
+    channel &operator=(const channel &) = delete;
+
+    /**
+     * @brief  在槽位中直接构造一个元素(不阻塞)
+     * @param  args: 输入参数, 元素的构造参数
+     * @return true : 成功
+     * @return false: 通道已满
+     */
+    template <typename... Args>
+    bool emplace(Args &&...args)
+    {
+        if constexpr (std::is_nothrow_constructible<T, Args...>::value)
+        {
+            uint32_t pos = 0;
+            slot_t *slot = claim_put(pos);
+            if (!slot)
+            {
+                return false;
+            }
+
+            new (slot->storage) T(std::forward<Args>(args)...);
+
+            // 发布槽位, 序号等于pos + 1表示槽位中有数据
+            __atomic_store_n(&slot->seq, (pos + 1), __ATOMIC_RELEASE);
+
+            waiter_.wake(1);
+
+            return true;
+        }
+        else
+        {
+            // 构造可能抛出异常, 先在槽位之外构造, 避免已抢占的槽位无法发布
+            T value(std::forward<Args>(args)...);
+
+            return emplace(std::move(value));
+        }
+    }
+
+    /**
+     * @brief  移动写入一个元素(不阻塞, 失败时元素保持不变)
+     * @param  value: 输入参数, 待插入元素
+     * @return true : 成功
+     * @return false: 通道已满
+     */
+    bool try_push(T &&value) noexcept
+    {
+        return emplace(std::move(value));
+    }
+
+    /**
+     * @brief  拷贝写入一个元素(不阻塞)
+     * @param  value: 输入参数, 待插入元素
+     * @return true : 成功
+     * @return false: 通道已满
+     */
+    bool try_push(const T &value)
+    {
+        return emplace(value);
+    }
+
+    /**
+     * @brief  读取一个元素(不阻塞)
+     * @return 获取到的元素(通道为空时无值)
+     */
+    std::optional<T> try_pop() noexcept
+    {
+        std::optional<T> value;
+        pop_one(value);
+
+        return value;
+    }
+
+    /**
+     * @brief  阻塞方式读取一个元素
+     * @return 获取到的元素
+     */
+    std::optional<T> pop() noexcept
+    {
+        std::optional<T> value;
+        waiter_.wait([&]() { return pop_one(value); }, nullptr);
+
+        return value;
+    }
+
+    /**
+     * @brief  超时方式读取一个元素(超时时间为0, 直接读取)
+     * @param  timeout: 输入参数, 超时时间(单位: ms)
+     * @return 获取到的元素(超时时无值)
+     */
+    std::optional<T> pop(const uint32_t timeout) noexcept
+    {
+        if (0 == timeout)
+        {
+            return try_pop();
+        }
+
+        // 等待信号的结束时间
+        struct timespec end_time = {0, 0};
+        queue_sys_deadline_after_ms(&end_time, timeout);
+
+        std::optional<T> value;
+        waiter_.wait([&]() { return pop_one(value); }, &end_time);
+
+        return value;
+    }
+
+    /**
+     * @brief  批量读取元素(不阻塞)
+     * @param  out: 输出参数, 输出迭代器, 获取到的元素依次移动赋值给*out
+     * @param  num: 输入参数, 指定获取元素个数
+     * @return 实际获取元素个数
+     */
+    template <typename OutputIt>
+    uint32_t pop_n(OutputIt out, const uint32_t num)
+    {
+        uint32_t get_num = 0;
+        std::optional<T> value;
+
+        while ((get_num < num) && (pop_one(value)))
+        {
+            *out = std::move(*value);
+            ++out;
+            value.reset();
+            get_num++;
+        }
+
+        return get_num;
+    }
+
+    /**
+     * @brief  清空通道, 销毁剩余的元素
+     */
+    void clear() noexcept
+    {
+        std::optional<T> value;
+        while (pop_one(value))
+        {
+            value.reset();
+        }
+    }
+
+    /**
+     * @brief  获取通道当前元素个数(并发读写时为近似值)
+     * @return 通道当前元素个数
+     */
+    uint32_t size() const noexcept
+    {
+        uint32_t head = __atomic_load_n(&head_, __ATOMIC_ACQUIRE);
+        uint32_t tail = __atomic_load_n(&tail_, __ATOMIC_ACQUIRE);
+        uint32_t used_size = (tail - head);
+
+        // 两次读取之间位置可能变化, 限制在容量范围内
+        return (((int32_t)used_size < 0) ? 0 : ((used_size > capacity_) ? capacity_ : used_size));
+    }
+
+    /**
+     * @brief  判断通道是否为空
+     * @return true : 通道为空
+     * @return false: 通道非空
+     */
+    bool empty() const noexcept
+    {
+        return (0 == size());
+    }
+
+    /**
+     * @brief  获取通道容量
+     * @return 通道容量(元素个数)
+     */
+    uint32_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+private:
+    struct slot_t
+    {
+        uint32_t seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    /**
+     * @brief  抢占一个可写入的槽位
+     * @param  pos: 输出参数, 写入位置
+     * @return 成功: 槽位
+     *         失败: nullptr(通道已满)
+     */
+    inline slot_t *claim_put(uint32_t &pos) noexcept
+    {
+        pos = __atomic_load_n(&tail_, __ATOMIC_RELAXED);
+
+        while (true)
+        {
+            slot_t *slot = &slots_[pos & mask_];
+            int32_t diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+
+            // 槽位空闲, 抢占写入位置
+            if (0 == diff)
+            {
+                if (__atomic_compare_exchange_n(&tail_, &pos, (pos + 1), true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                {
+                    return slot;
+                }
+            }
+            // 槽位中的元素还未被消费, 通道已满
+            else if (diff < 0)
+            {
+                return nullptr;
+            }
+            // 写入位置已被其他生产者抢占
+            else
+            {
+                pos = __atomic_load_n(&tail_, __ATOMIC_RELAXED);
+            }
+        }
+    }
+
+    /**
+     * @brief  读取一个元素(不阻塞), 槽位中的元素移动给调用者后销毁
+     * @param  value: 输出参数, 获取到的元素
+     * @return true : 成功
+     * @return false: 通道为空
+     */
+    inline bool pop_one(std::optional<T> &value) noexcept
+    {
+        slot_t *slot = nullptr;
+        uint32_t pos = __atomic_load_n(&head_, __ATOMIC_RELAXED);
+
+        while (true)
+        {
+            slot = &slots_[pos & mask_];
+            int32_t diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - (pos + 1));
+
+            // 槽位中有数据, 抢占读取位置
+            if (0 == diff)
+            {
+                if (__atomic_compare_exchange_n(&head_, &pos, (pos + 1), true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                {
+                    break;
+                }
+            }
+            // 槽位还未写入, 通道为空
+            else if (diff < 0)
+            {
+                return false;
+            }
+            // 读取位置已被其他消费者抢占
+            else
+            {
+                pos = __atomic_load_n(&head_, __ATOMIC_RELAXED);
+            }
+        }
+
+        T *element = std::launder(reinterpret_cast<T *>(slot->storage));
+        value.emplace(std::move(*element));
+        element->~T();
+
+        // 释放槽位, 序号前进一圈供下一轮生产者使用
+        __atomic_store_n(&slot->seq, (pos + capacity_), __ATOMIC_RELEASE);
+
+        return true;
+    }
+
+    // 只读区
+    slot_t *slots_ = nullptr; // 槽位数组
+    uint32_t capacity_ = 0;   // 槽位个数(2的幂)
+    uint32_t mask_ = 0;       // 下标掩码(capacity_ - 1)
+
+    // 生产者区
+    alignas(QUEUE_CACHE_LINE_SIZE) uint32_t tail_ = 0; // 写入位置(自由递增)
+
+    // 消费者区
+    alignas(QUEUE_CACHE_LINE_SIZE) uint32_t head_ = 0; // 读取位置(自由递增)
+
+    // 阻塞等待区
+    alignas(QUEUE_CACHE_LINE_SIZE) detail::futex_waiter waiter_;
+};
+
+} // namespace linux_queue
+
+#endif // __QUEUE_HPP
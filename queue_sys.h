@@ -0,0 +1,219 @@
+/**
+ * @file      : queue_sys.h
+ * @brief     : Linux平台队列驱动内部辅助函数(futex等待/唤醒, 超时计算, 镜像映射)
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-16 10:30:00
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-16 huenrong        创建文件
+ *
+ */
+
+#ifndef __QUEUE_SYS_H
+#define __QUEUE_SYS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <linux/memfd.h>
+
+/**
+ * @brief  计算超时结束时间(CLOCK_MONOTONIC时钟)
+ * @param  deadline  : 输出参数, 超时结束时间
+ * @param  timeout_ns: 输入参数, 超时时间(单位: ns)
+ */
+static inline void queue_sys_deadline_after_ns(struct timespec *deadline, const uint64_t timeout_ns)
+{
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+
+    deadline->tv_sec += (time_t)(timeout_ns / 1000000000);
+    deadline->tv_nsec += (long)(timeout_ns % 1000000000);
+
+    // tv_nsec必须小于1S
+    if (deadline->tv_nsec >= 1000000000)
+    {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000;
+    }
+}
+
+/**
+ * @brief  计算超时结束时间(CLOCK_MONOTONIC时钟)
+ * @param  deadline: 输出参数, 超时结束时间
+ * @param  timeout : 输入参数, 超时时间(单位: ms)
+ */
+static inline void queue_sys_deadline_after_ms(struct timespec *deadline, const uint32_t timeout)
+{
+    queue_sys_deadline_after_ns(deadline, ((uint64_t)timeout * 1000000));
+}
+
+/**
+ * @brief  获取当前时间
+ * @param  clock_id: 输入参数, 时钟(CLOCK_MONOTONIC或CLOCK_REALTIME)
+ * @return 当前时间(单位: ns)
+ */
+static inline uint64_t queue_sys_get_time_ns(const clockid_t clock_id)
+{
+    struct timespec now = {0, 0};
+    clock_gettime(clock_id, &now);
+
+    return (((uint64_t)now.tv_sec * 1000000000) + (uint64_t)now.tv_nsec);
+}
+
+/**
+ * @brief  时间转换为纳秒
+ * @param  time: 输入参数, 时间
+ * @return 时间(单位: ns)
+ */
+static inline uint64_t queue_sys_timespec_to_ns(const struct timespec *time)
+{
+    return (((uint64_t)time->tv_sec * 1000000000) + (uint64_t)time->tv_nsec);
+}
+
+/**
+ * @brief  自旋等待时降低CPU功耗和流水线冲突
+ */
+static inline void queue_sys_cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+/**
+ * @brief  futex等待, 地址上的值不等于期望值时立即返回
+ * @param  addr    : 输入参数, 等待地址
+ * @param  value   : 输入参数, 期望值
+ * @param  deadline: 输入参数, 超时结束时间(CLOCK_MONOTONIC时钟, 为NULL时一直等待)
+ * @return 0        : 被唤醒, 值已改变或被信号打断(调用者需重新检查条件)
+ * @return ETIMEDOUT: 超时
+ */
+static inline int queue_sys_futex_wait(uint32_t *addr, const uint32_t value, const struct timespec *deadline)
+{
+    // 使用FUTEX_WAIT_BITSET, 超时时间为CLOCK_MONOTONIC时钟的绝对时间, 多次等待可复用同一个结束时间
+    long ret = syscall(SYS_futex, addr, (FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG), value, deadline, NULL,
+                       FUTEX_BITSET_MATCH_ANY);
+    if ((-1 == ret) && (ETIMEDOUT == errno))
+    {
+        return ETIMEDOUT;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  futex唤醒
+ * @param  addr      : 输入参数, 等待地址
+ * @param  wake_count: 输入参数, 最多唤醒的线程个数(INT_MAX表示全部唤醒)
+ */
+static inline void queue_sys_futex_wake(uint32_t *addr, const int wake_count)
+{
+    syscall(SYS_futex, addr, (FUTEX_WAKE | FUTEX_PRIVATE_FLAG), wake_count, NULL, NULL, 0);
+}
+
+/**
+ * @brief  创建事件fd(非阻塞, 计数不为0时可读)
+ * @return 成功: 事件fd
+ *         失败: -1
+ */
+static inline int queue_sys_event_create(void)
+{
+    return eventfd(0, (EFD_NONBLOCK | EFD_CLOEXEC));
+}
+
+/**
+ * @brief  置位事件fd, 使其可读
+ * @param  fd: 输入参数, 事件fd
+ */
+static inline void queue_sys_event_set(const int fd)
+{
+    uint64_t value = 1;
+    ssize_t ret = write(fd, &value, sizeof(value));
+    (void)ret;
+}
+
+/**
+ * @brief  清除事件fd, 使其不可读
+ * @param  fd: 输入参数, 事件fd
+ */
+static inline void queue_sys_event_clear(const int fd)
+{
+    uint64_t value = 0;
+    ssize_t ret = read(fd, &value, sizeof(value));
+    (void)ret;
+}
+
+/**
+ * @brief  创建镜像映射: 同一块匿名内存在虚拟地址上连续映射两次
+ *         访问[addr + len, addr + 2 * len)等同于访问[addr, addr + len), 跨越末尾的读写无需回绕
+ * @param  len: 输入参数, 内存大小(必须是页大小的整数倍)
+ * @return 成功: 映射首地址
+ *         失败: NULL
+ */
+static inline uint8_t *queue_sys_mirror_map(const uint32_t len)
+{
+    int fd = (int)syscall(SYS_memfd_create, "linux_queue", MFD_CLOEXEC);
+    if (-1 == fd)
+    {
+        return NULL;
+    }
+
+    if (-1 == ftruncate(fd, len))
+    {
+        close(fd);
+
+        return NULL;
+    }
+
+    // 先预留两倍大小的连续地址空间, 再把同一个文件固定映射到前后两半
+    size_t map_len = ((size_t)len * 2);
+    uint8_t *addr = (uint8_t *)mmap(NULL, map_len, PROT_NONE, (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+    if (MAP_FAILED == addr)
+    {
+        close(fd);
+
+        return NULL;
+    }
+
+    if ((MAP_FAILED == mmap(addr, len, (PROT_READ | PROT_WRITE), (MAP_SHARED | MAP_FIXED), fd, 0)) ||
+        (MAP_FAILED == mmap(&addr[len], len, (PROT_READ | PROT_WRITE), (MAP_SHARED | MAP_FIXED), fd, 0)))
+    {
+        munmap(addr, map_len);
+        close(fd);
+
+        return NULL;
+    }
+
+    // 映射建立后文件描述符不再需要, 内存随映射解除释放
+    close(fd);
+
+    return addr;
+}
+
+/**
+ * @brief  解除镜像映射
+ * @param  addr: 输入参数, 映射首地址
+ * @param  len : 输入参数, 内存大小(与创建时一致)
+ */
+static inline void queue_sys_mirror_unmap(uint8_t *addr, const uint32_t len)
+{
+    if (addr)
+    {
+        munmap(addr, ((size_t)len * 2));
+    }
+}
+
+#endif // __QUEUE_SYS_H
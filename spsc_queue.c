@@ -0,0 +1,319 @@
+/**
+ * @file      : spsc_queue.c
+ * @brief     : Linux平台单生产者单消费者无锁队列驱动源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-16 10:30:00
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-16 huenrong        创建文件
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./spsc_queue.h"
+#include "./queue_sys.h"
+
+/**
+ * @brief  从队列中读取数据(消费者线程调用, 不阻塞)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @return 实际获取个数
+ */
+static uint32_t spsc_queue_read(spsc_queue_t *queue_name, uint8_t *data, const uint32_t data_len)
+{
+    // 队列头指针只由消费者修改, 无需原子读
+    uint32_t head = queue_name->head;
+
+    // 优先使用缓存的队列尾指针, 数据不够时才读取生产者的缓存行
+    uint32_t used_size = (queue_name->cached_tail - head);
+    if (used_size < data_len)
+    {
+        queue_name->cached_tail = __atomic_load_n(&queue_name->tail, __ATOMIC_ACQUIRE);
+        used_size = (queue_name->cached_tail - head);
+    }
+
+    uint32_t get_num = ((used_size < data_len) ? used_size : data_len);
+    if (0 == get_num)
+    {
+        return 0;
+    }
+
+    // 最多分两段拷贝
+    uint32_t index = (head & queue_name->mask);
+    uint32_t first_len = (queue_name->total_size - index);
+    if (first_len > get_num)
+    {
+        first_len = get_num;
+    }
+    memcpy(data, &queue_name->data[index], first_len);
+    if (get_num > first_len)
+    {
+        memcpy(&data[first_len], queue_name->data, (get_num - first_len));
+    }
+
+    // 数据拷贝完成后再发布队列头指针, 生产者才能复用这段空间
+    __atomic_store_n(&queue_name->head, (head + get_num), __ATOMIC_RELEASE);
+
+    return get_num;
+}
+
+/**
+ * @brief  从队列中获取数据(消费者线程调用)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @param  deadline  : 输入参数, 超时结束时间(CLOCK_MONOTONIC时钟, 为NULL时一直等待)
+ * @return 成功: 实际获取个数
+ *         失败: -1
+ */
+static int spsc_queue_read_wait(spsc_queue_t *queue_name, uint8_t *data, const uint32_t data_len,
+                                const struct timespec *deadline)
+{
+    while (true)
+    {
+        uint32_t get_num = spsc_queue_read(queue_name, data, data_len);
+        if (get_num > 0)
+        {
+            return get_num;
+        }
+
+        // 先设置休眠标志再检查队列, 与生产者"先发布尾指针再检查休眠标志"配对, 避免丢失唤醒
+        __atomic_store_n(&queue_name->waiting, 1, __ATOMIC_SEQ_CST);
+        uint32_t head = queue_name->head;
+        if (__atomic_load_n(&queue_name->tail, __ATOMIC_SEQ_CST) != head)
+        {
+            __atomic_store_n(&queue_name->waiting, 0, __ATOMIC_RELAXED);
+
+            continue;
+        }
+
+        // 直接等待在队列尾指针上, 尾指针改变后futex立即返回
+        int ret = queue_sys_futex_wait(&queue_name->tail, head, deadline);
+
+        __atomic_store_n(&queue_name->waiting, 0, __ATOMIC_RELAXED);
+
+        // 超时, 最后再尝试读取一次
+        if (ETIMEDOUT == ret)
+        {
+            get_num = spsc_queue_read(queue_name, data, data_len);
+
+            return ((get_num > 0) ? (int)get_num : -1);
+        }
+    }
+}
+
+/**
+ * @brief  初始化单生产者单消费者队列
+ * @param  queue_name: 输出参数, 队列名
+ * @param  queue_size: 输入参数, 队列最小容量(向上取整为2的幂, 不能超过2^31)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool spsc_queue_init(spsc_queue_t *queue_name, const uint32_t queue_size)
+{
+    if ((!queue_name) || (!queue_size) || (queue_size > (1U << 31)))
+    {
+        return false;
+    }
+
+    // 容量向上取整为2的幂
+    uint32_t len = 1;
+    while (len < queue_size)
+    {
+        len <<= 1;
+    }
+
+    memset(queue_name, 0, sizeof(spsc_queue_t));
+
+    queue_name->data = (uint8_t *)malloc(len);
+    if (!queue_name->data)
+    {
+        return false;
+    }
+
+    queue_name->total_size = len;
+    queue_name->mask = (len - 1);
+
+    return true;
+}
+
+/**
+ * @brief  清空队列(只能在消费者线程中调用)
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool spsc_queue_clear(spsc_queue_t *queue_name)
+{
+    if (!queue_name)
+    {
+        return false;
+    }
+
+    // 队列头指针追上当前的队列尾指针即为清空
+    queue_name->cached_tail = __atomic_load_n(&queue_name->tail, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&queue_name->head, queue_name->cached_tail, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+/**
+ * @brief  获取队列当前元素个数
+ * @param  queue_name: 输入参数, 队列名
+ * @return 队列当前元素个数
+ */
+uint32_t spsc_queue_get_current_size(const spsc_queue_t *queue_name)
+{
+    if (!queue_name)
+    {
+        return 0;
+    }
+
+    uint32_t head = __atomic_load_n(&queue_name->head, __ATOMIC_ACQUIRE);
+    uint32_t tail = __atomic_load_n(&queue_name->tail, __ATOMIC_ACQUIRE);
+
+    return (tail - head);
+}
+
+/**
+ * @brief  写入数据到队列(只能在生产者线程中调用)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return 成功: 实际插入个数
+ *         失败: -1
+ */
+int spsc_queue_put_data(spsc_queue_t *queue_name, const uint8_t *data, const uint32_t data_len)
+{
+    if ((!queue_name) || (!data) || (!data_len))
+    {
+        return -1;
+    }
+
+    // 队列尾指针只由生产者修改, 无需原子读
+    uint32_t tail = queue_name->tail;
+
+    // 优先使用缓存的队列头指针, 空间不够时才读取消费者的缓存行
+    uint32_t free_size = (queue_name->total_size - (tail - queue_name->cached_head));
+    if (free_size < data_len)
+    {
+        queue_name->cached_head = __atomic_load_n(&queue_name->head, __ATOMIC_ACQUIRE);
+        free_size = (queue_name->total_size - (tail - queue_name->cached_head));
+    }
+
+    uint32_t put_num = ((free_size < data_len) ? free_size : data_len);
+    if (0 == put_num)
+    {
+        return 0;
+    }
+
+    // 最多分两段拷贝
+    uint32_t index = (tail & queue_name->mask);
+    uint32_t first_len = (queue_name->total_size - index);
+    if (first_len > put_num)
+    {
+        first_len = put_num;
+    }
+    memcpy(&queue_name->data[index], data, first_len);
+    if (put_num > first_len)
+    {
+        memcpy(queue_name->data, &data[first_len], (put_num - first_len));
+    }
+
+    // 数据拷贝完成后再发布队列尾指针
+    __atomic_store_n(&queue_name->tail, (tail + put_num), __ATOMIC_RELEASE);
+
+    // 只有消费者因队列为空而休眠时才进入内核唤醒
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if ((__atomic_load_n(&queue_name->waiting, __ATOMIC_RELAXED)) &&
+        (__atomic_exchange_n(&queue_name->waiting, 0, __ATOMIC_ACQ_REL)))
+    {
+        queue_sys_futex_wake(&queue_name->tail, 1);
+    }
+
+    return put_num;
+}
+
+/**
+ * @brief  阻塞方式从队列中获取数据(只能在消费者线程中调用)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @return 成功: 实际获取个数
+ *         失败: -1
+ */
+int spsc_queue_get_data(spsc_queue_t *queue_name, uint8_t *data, const uint32_t data_len)
+{
+    if ((!queue_name) || (!data) || (!data_len))
+    {
+        return -1;
+    }
+
+    return spsc_queue_read_wait(queue_name, data, data_len, NULL);
+}
+
+/**
+ * @brief  超时方式从队列中获取数据(超时时间为0, 直接从队列获取数据, 只能在消费者线程中调用)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际获取个数
+ *         失败: -1
+ */
+int spsc_queue_get_data_with_timeout(spsc_queue_t *queue_name, uint8_t *data, const uint32_t data_len,
+                                     const uint32_t timeout)
+{
+    if ((!queue_name) || (!data) || (!data_len))
+    {
+        return -1;
+    }
+
+    if (0 == timeout)
+    {
+        return spsc_queue_read(queue_name, data, data_len);
+    }
+
+    // 等待信号的结束时间
+    struct timespec end_time = {0};
+    queue_sys_deadline_after_ms(&end_time, timeout);
+
+    return spsc_queue_read_wait(queue_name, data, data_len, &end_time);
+}
+
+/**
+ * @brief  判断队列是否为空
+ * @param  queue_name: 输入参数, 队列名
+ * @return true : 队列为空
+ * @return false: 队列非空
+ */
+bool spsc_queue_is_empty(const spsc_queue_t *queue_name)
+{
+    return ((!spsc_queue_get_current_size(queue_name)) ? true : false);
+}
+
+/**
+ * @brief  销毁队列
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool spsc_queue_destroy(spsc_queue_t *queue_name)
+{
+    if (!queue_name)
+    {
+        return false;
+    }
+
+    free(queue_name->data);
+
+    memset(queue_name, 0, sizeof(spsc_queue_t));
+
+    return true;
+}
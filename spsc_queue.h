@@ -0,0 +1,127 @@
+/**
+ * @file      : spsc_queue.h
+ * @brief     : Linux平台单生产者单消费者无锁队列驱动头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-16 10:30:00
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-16 huenrong        创建文件
+ *
+ */
+
+#ifndef __SPSC_QUEUE_H
+#define __SPSC_QUEUE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef QUEUE_CACHE_LINE_SIZE
+#define QUEUE_CACHE_LINE_SIZE 64 // 缓存行大小
+#endif
+
+// 单生产者单消费者无锁队列结构体
+// 只允许一个生产者线程写入, 一个消费者线程读取
+// 生产者和消费者的指针分别位于独立的缓存行, 避免伪共享
+typedef struct
+{
+    // 只读区
+    uint8_t *data;       // 指向缓冲区的指针
+    uint32_t total_size; // 队列缓冲区的总大小(2的幂)
+    uint32_t mask;       // 下标掩码(total_size - 1)
+
+    // 生产者区
+    uint32_t tail __attribute__((aligned(QUEUE_CACHE_LINE_SIZE))); // 队列尾指针(自由递增)
+    uint32_t cached_head;                                          // 生产者缓存的队列头指针
+
+    // 消费者区
+    uint32_t head __attribute__((aligned(QUEUE_CACHE_LINE_SIZE))); // 队列头指针(自由递增)
+    uint32_t cached_tail;                                          // 消费者缓存的队列尾指针
+
+    // 消费者休眠标志, 很少修改, 单独占用一个缓存行
+    uint32_t waiting __attribute__((aligned(QUEUE_CACHE_LINE_SIZE)));
+} spsc_queue_t;
+
+/**
+ * @brief  初始化单生产者单消费者队列
+ * @param  queue_name: 输出参数, 队列名
+ * @param  queue_size: 输入参数, 队列最小容量(向上取整为2的幂, 不能超过2^31)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool spsc_queue_init(spsc_queue_t *queue_name, const uint32_t queue_size);
+
+/**
+ * @brief  清空队列(只能在消费者线程中调用)
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool spsc_queue_clear(spsc_queue_t *queue_name);
+
+/**
+ * @brief  获取队列当前元素个数
+ * @param  queue_name: 输入参数, 队列名
+ * @return 队列当前元素个数
+ */
+uint32_t spsc_queue_get_current_size(const spsc_queue_t *queue_name);
+
+/**
+ * @brief  写入数据到队列(只能在生产者线程中调用)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输入参数, 待插入数据
+ * @param  data_len  : 输入参数, 待插入数据长度
+ * @return 成功: 实际插入个数
+ *         失败: -1
+ */
+int spsc_queue_put_data(spsc_queue_t *queue_name, const uint8_t *data, const uint32_t data_len);
+
+/**
+ * @brief  阻塞方式从队列中获取数据(只能在消费者线程中调用)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @return 成功: 实际获取个数
+ *         失败: -1
+ */
+int spsc_queue_get_data(spsc_queue_t *queue_name, uint8_t *data, const uint32_t data_len);
+
+/**
+ * @brief  超时方式从队列中获取数据(超时时间为0, 直接从队列获取数据, 只能在消费者线程中调用)
+ * @param  queue_name: 输出参数, 队列名
+ * @param  data      : 输出参数, 获取到的数据
+ * @param  data_len  : 输入参数, 指定获取长度
+ * @param  timeout   : 输入参数, 超时时间(单位: ms)
+ * @return 成功: 实际获取个数
+ *         失败: -1
+ */
+int spsc_queue_get_data_with_timeout(spsc_queue_t *queue_name, uint8_t *data, const uint32_t data_len,
+                                     const uint32_t timeout);
+
+/**
+ * @brief  判断队列是否为空
+ * @param  queue_name: 输入参数, 队列名
+ * @return true : 队列为空
+ * @return false: 队列非空
+ */
+bool spsc_queue_is_empty(const spsc_queue_t *queue_name);
+
+/**
+ * @brief  销毁队列
+ * @param  queue_name: 输出参数, 队列名
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool spsc_queue_destroy(spsc_queue_t *queue_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SPSC_QUEUE_H
@@ -0,0 +1,225 @@
+/**
+ * @file      : queue_persist_kill_test.c
+ * @brief     : 持久化队列异常退出恢复测试
+ *              子进程循环读写持久化队列, 父进程在随机时间kill -9子进程后重新打开文件,
+ *              检查文件能够恢复, 且恢复出的消息完整、连续
+ *              另外检查创建文件时未完成初始化(文件标志为0)、且大小与再次打开时的容量不同的文件能够重新初始化
+ *              编译: gcc -std=gnu11 -O2 -pthread -I.. queue_persist_kill_test.c ../queue.c -o queue_persist_kill_test
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-16 22:00:00
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-16 huenrong        创建文件
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "queue.h"
+
+#define TEST_RUN_NUM 600      // 测试次数
+#define TEST_QUEUE_SIZE 1000  // 队列容量(普通模式, 有间隔元素)
+#define TEST_MAX_MSG_LEN 64   // 最大消息长度
+#define TEST_MAX_RUN_US 20000 // 子进程最长运行时间(单位: us)
+
+/**
+ * @brief  生成消息: 前4字节为序号, 之后每个字节由序号推导
+ * @param  msg: 输出参数, 消息
+ * @param  seq: 输入参数, 序号
+ * @return 消息长度
+ */
+static uint32_t test_make_msg(uint8_t *msg, const uint32_t seq)
+{
+    uint32_t len = (sizeof(seq) + (seq % (TEST_MAX_MSG_LEN - sizeof(seq))));
+
+    memcpy(msg, &seq, sizeof(seq));
+    for (uint32_t i = sizeof(seq); i < len; i++)
+    {
+        msg[i] = (uint8_t)(seq + i);
+    }
+
+    return len;
+}
+
+/**
+ * @brief  子进程: 循环写入消息, 每写入两条读取一条, 直到被杀死
+ * @param  path    : 输入参数, 文件路径
+ * @param  base_seq: 输入参数, 起始序号
+ */
+static void test_child(const char *path, const uint32_t base_seq)
+{
+    queue_t *queue = queue_init_persistent(path, TEST_QUEUE_SIZE);
+    if (!queue)
+    {
+        _exit(1);
+    }
+
+    uint8_t msg[TEST_MAX_MSG_LEN] = {0};
+    uint8_t buf[TEST_MAX_MSG_LEN] = {0};
+    for (uint32_t seq = base_seq;; seq++)
+    {
+        uint32_t len = test_make_msg(msg, seq);
+        while (0 == queue_put_msg(queue, msg, len, 0))
+        {
+            queue_get_msg(queue, buf, sizeof(buf), 0);
+        }
+
+        if (seq & 1)
+        {
+            queue_get_msg(queue, buf, sizeof(buf), 0);
+        }
+    }
+}
+
+/**
+ * @brief  父进程: 恢复文件并检查消息, 检查后读空队列
+ * @param  path: 输入参数, 文件路径
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool test_check(const char *path)
+{
+    queue_t *queue = queue_init_persistent(path, TEST_QUEUE_SIZE);
+    if (!queue)
+    {
+        printf("recover failed\n");
+
+        return false;
+    }
+
+    // 恢复出的消息必须完整, 且序号连续
+    bool ret = true;
+    uint8_t msg[TEST_MAX_MSG_LEN] = {0};
+    uint8_t expect[TEST_MAX_MSG_LEN] = {0};
+    uint32_t last_seq = 0;
+    uint32_t msg_num = 0;
+    uint64_t dropped_bytes = queue_get_dropped_bytes(queue);
+    int len = 0;
+    while ((len = queue_get_msg(queue, msg, sizeof(msg), 0)) > 0)
+    {
+        uint32_t seq = 0;
+        memcpy(&seq, msg, sizeof(seq));
+        if (((uint32_t)len != test_make_msg(expect, seq)) || (0 != memcmp(msg, expect, len)) ||
+            ((msg_num > 0) && (seq != (last_seq + 1))))
+        {
+            printf("bad message: seq = %u, len = %d, last_seq = %u\n", seq, len, last_seq);
+            ret = false;
+
+            break;
+        }
+
+        last_seq = seq;
+        msg_num++;
+    }
+
+    // 读取过程中不能因校验失败丢弃数据
+    if (queue_get_dropped_bytes(queue) != dropped_bytes)
+    {
+        printf("dropped %llu bytes\n", (unsigned long long)(queue_get_dropped_bytes(queue) - dropped_bytes));
+        ret = false;
+    }
+
+    queue_clear(queue);
+    queue_close_persistent(queue);
+
+    return ret;
+}
+
+/**
+ * @brief  检查未完成初始化的文件: 文件全为0(创建进程写入文件标志前退出), 大小与本次请求的容量不同
+ * @param  path: 输入参数, 文件路径
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool test_uninit_file(const char *path)
+{
+    // 上次创建时请求的容量远大于本次
+    off_t uninit_size = (TEST_QUEUE_SIZE * 64);
+    int fd = open(path, (O_RDWR | O_CREAT | O_TRUNC), 0600);
+    if ((-1 == fd) || (-1 == ftruncate(fd, uninit_size)))
+    {
+        printf("create uninit file failed\n");
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+
+        return false;
+    }
+    close(fd);
+
+    queue_t *queue = queue_init_persistent(path, TEST_QUEUE_SIZE);
+    if (!queue)
+    {
+        printf("open uninit file failed\n");
+
+        return false;
+    }
+
+    // 重新初始化后文件按本次请求的容量扩展
+    bool ret = true;
+    struct stat st = {0};
+    uint8_t msg[TEST_MAX_MSG_LEN] = {0};
+    uint8_t buf[TEST_MAX_MSG_LEN] = {0};
+    uint32_t len = test_make_msg(msg, 1);
+    if ((0 != stat(path, &st)) || (uninit_size == st.st_size) || ((int)len != queue_put_msg(queue, msg, len, 0)) ||
+        ((int)len != queue_get_msg(queue, buf, sizeof(buf), 0)) || (0 != memcmp(msg, buf, len)))
+    {
+        printf("uninit file reinit failed\n");
+        ret = false;
+    }
+
+    queue_close_persistent(queue);
+    unlink(path);
+
+    return ret;
+}
+
+int main(void)
+{
+    char path[64] = {0};
+    snprintf(path, sizeof(path), "/tmp/queue_persist_kill_test_%d", (int)getpid());
+    unlink(path);
+
+    if (!test_uninit_file(path))
+    {
+        return 1;
+    }
+    srand((unsigned int)time(NULL));
+
+    for (uint32_t i = 0; i < TEST_RUN_NUM; i++)
+    {
+        pid_t pid = fork();
+        if (0 == pid)
+        {
+            test_child(path, (i * 1000000));
+        }
+
+        usleep(rand() % TEST_MAX_RUN_US);
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+
+        if (!test_check(path))
+        {
+            printf("run %u failed\n", i);
+            unlink(path);
+
+            return 1;
+        }
+    }
+
+    unlink(path);
+    printf("%d runs passed\n", TEST_RUN_NUM);
+
+    return 0;
+}
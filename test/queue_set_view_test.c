@@ -0,0 +1,130 @@
+/**
+ * @file      : queue_set_view_test.c
+ * @brief     : 队列集合与消费者视图测试
+ *              主线程持有消费者视图时, 另一个线程在队列集合上等待, 检查等待线程休眠而不是空转,
+ *              视图释放且还有剩余数据后等待线程被唤醒并读取到剩余数据
+ *              编译: gcc -std=gnu11 -O2 -pthread -I.. queue_set_view_test.c ../queue.c -o queue_set_view_test
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-17 00:00:00
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-17 huenrong        创建文件
+ *
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include "queue.h"
+
+#define TEST_QUEUE_SIZE 64        // 队列容量
+#define TEST_VIEW_HOLD_US 300000  // 视图持有时间(单位: us)
+#define TEST_MAX_WAIT_CPU_US 5000 // 等待线程允许消耗的最大CPU时间(单位: us)
+
+static queue_t test_queue;   // 测试队列
+static queue_set_t test_set; // 测试队列集合
+
+static volatile int wait_ret = 0;       // 等待线程的queue_set_wait()返回值
+static volatile int get_ret = 0;        // 等待线程获取到的数据长度
+static volatile bool wait_done = false; // 等待线程是否已返回
+static uint64_t wait_cpu_us = 0;        // 等待线程消耗的CPU时间(单位: us)
+
+/**
+ * @brief  等待线程: 在队列集合上等待, 返回后读取数据
+ * @param  arg: 输入参数, 未使用
+ * @return NULL
+ */
+static void *test_wait_thread(void *arg)
+{
+    (void)arg;
+
+    queue_t *ready = NULL;
+    wait_ret = queue_set_wait(&test_set, &ready, 1);
+
+    struct rusage usage = {0};
+    getrusage(RUSAGE_THREAD, &usage);
+    wait_cpu_us = (((uint64_t)usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 + usage.ru_utime.tv_usec +
+                   usage.ru_stime.tv_usec);
+
+    uint8_t data[TEST_QUEUE_SIZE] = {0};
+    get_ret = ((ready == &test_queue) ? queue_get_data_with_timeout(&test_queue, data, sizeof(data), 0) : -1);
+    __atomic_store_n(&wait_done, true, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+int main(void)
+{
+    if ((!queue_init(&test_queue, TEST_QUEUE_SIZE)) || (!queue_set_init(&test_set)) ||
+        (!queue_set_add(&test_set, &test_queue)))
+    {
+        printf("init failed\n");
+
+        return 1;
+    }
+
+    // 队列中的全部数据都在视图中, 对其他消费者不可读
+    uint8_t data[4] = {1, 2, 3, 4};
+    queue_segment_t seg1 = {0};
+    queue_segment_t seg2 = {0};
+    if ((sizeof(data) != queue_put_data(&test_queue, data, sizeof(data))) ||
+        (sizeof(data) != queue_get_view(&test_queue, &seg1, &seg2, 0)))
+    {
+        printf("get view failed\n");
+
+        return 1;
+    }
+
+    pthread_t wait_thread;
+    if (0 != pthread_create(&wait_thread, NULL, test_wait_thread, NULL))
+    {
+        printf("pthread create failed\n");
+
+        return 1;
+    }
+
+    // 视图持有期间等待线程不能返回
+    usleep(TEST_VIEW_HOLD_US);
+    if (__atomic_load_n(&wait_done, __ATOMIC_ACQUIRE))
+    {
+        printf("queue_set_wait returned while data was viewed: ret = %d\n", wait_ret);
+
+        return 1;
+    }
+
+    // 释放1字节后还剩3字节, 等待线程被唤醒并读取
+    queue_get_release(&test_queue, 1);
+    pthread_join(wait_thread, NULL);
+
+    int ret = 0;
+    if ((1 != wait_ret) || ((int)(sizeof(data) - 1) != get_ret))
+    {
+        printf("bad wakeup: wait_ret = %d, get_ret = %d\n", wait_ret, get_ret);
+        ret = 1;
+    }
+
+    // 等待线程应休眠等待, 而不是反复检查队列
+    if (wait_cpu_us > TEST_MAX_WAIT_CPU_US)
+    {
+        printf("waiter used %llu us of CPU while the view was held\n", (unsigned long long)wait_cpu_us);
+        ret = 1;
+    }
+
+    queue_set_remove(&test_set, &test_queue);
+    queue_set_destroy(&test_set);
+    queue_destroy(&test_queue);
+
+    if (0 == ret)
+    {
+        printf("queue set view test passed\n");
+    }
+
+    return ret;
+}